@@ -0,0 +1,356 @@
+// Microbenchmarks for the BoardLogic hot paths. Every benchmark runs over a
+// fixed-seed corpus of boards, so numbers are comparable between commits;
+// --json output is meant to be saved and diffed.
+//
+// Reports time per operation and heap allocations per operation. Global
+// operator new is replaced below to count allocations.
+
+#include "BoardCorpus.h"
+#include "SimdLevel.h"
+#include "TestHelpers.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+
+void* countedAlloc(size_t size) {
+    ++allocationCount;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* countedAlignedAlloc(size_t size, size_t alignment) {
+    ++allocationCount;
+#if defined(_MSC_VER)
+    void* memory = _aligned_malloc(std::max<size_t>(size, 1), alignment);
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment
+    size_t rounded = (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment;
+    void* memory = std::aligned_alloc(alignment, rounded);
+#endif
+    if (memory) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void alignedFree(void* memory) {
+#if defined(_MSC_VER)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+} // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return countedAlignedAlloc(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return countedAlignedAlloc(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { alignedFree(memory); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int CORPUS_SIZE = 64;
+const int SAMPLES = 5;
+
+// Keeps the compiler from discarding a result that is never read
+template <typename T>
+void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;  // Per sample
+    double nsPerOp = 0.0;     // Median of the samples
+    double allocsPerOp = 0.0;
+};
+
+struct BenchConfig {
+    double minSampleMs = 50.0;
+    std::string filter;
+    bool json = false;
+};
+
+// Times op(i) for i = 0, 1, 2, ... Iterations are doubled until one sample
+// takes minSampleMs, then SAMPLES samples are taken and the median kept.
+template <typename Op>
+BenchResult measure(const char* name, const BenchConfig& config, Op&& op) {
+    auto runSample = [&](uint64_t iterations) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            op(i);
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    uint64_t iterations = 1;
+    while (runSample(iterations) < config.minSampleMs * 1e6 && iterations < (1ull << 40)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    uint64_t allocations = 0;
+    for (int sample = 0; sample < SAMPLES; ++sample) {
+        uint64_t before = allocationCount;
+        samples.push_back(runSample(iterations) / static_cast<double>(iterations));
+        allocations += allocationCount - before;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = samples[SAMPLES / 2];
+    result.allocsPerOp = static_cast<double>(allocations) / (static_cast<double>(iterations) * SAMPLES);
+    return result;
+}
+
+// Corpora. Index i of each op uses board i % CORPUS_SIZE.
+
+// Random boards full of matches, plus hand-drawn shapes
+std::vector<BoardState> matchCorpus() {
+    std::vector<BoardState> boards;
+    boards.push_back(parseBoard({
+        "RRRGGBBY",
+        "GBYRPOGR",
+        "BYPRGRYB",
+        "YPORGGGY",
+        "PORGRBYP",
+        "ORGBYPOR",
+        "RGBYPORG",
+        "GBYPORGB",
+    }));
+    boards.push_back(noMatchBoard());
+    for (unsigned seed = 1; boards.size() < CORPUS_SIZE; ++seed) {
+        boards.push_back(randomBoard(seed));
+    }
+    return boards;
+}
+
+// Random boards with a third of the cells empty
+std::vector<BoardState> gravityCorpus() {
+    std::vector<BoardState> boards;
+    for (unsigned seed = 1; boards.size() < CORPUS_SIZE; ++seed) {
+        boards.push_back(randomBoard(seed, static_cast<int>(GemType::COUNT), 33));
+    }
+    return boards;
+}
+
+// Playable boards without matches, as the game sees them between moves
+std::vector<BoardState> playableCorpus() {
+    std::vector<BoardState> boards;
+    boards.push_back(noMatchBoard());
+    for (uint64_t seed = 1; boards.size() < CORPUS_SIZE; ++seed) {
+        BoardLogic logic(seed);
+        BoardState state;
+        logic.initializeBoard(state);
+        boards.push_back(state);
+    }
+    return boards;
+}
+
+std::vector<BenchResult> runBenchmarks(const BenchConfig& config) {
+    std::vector<BenchResult> results;
+    auto run = [&](const char* name, auto&& op) {
+        if (!config.filter.empty() && std::strstr(name, config.filter.c_str()) == nullptr) {
+            return;
+        }
+        results.push_back(measure(name, config, op));
+        if (!config.json) {
+            const BenchResult& result = results.back();
+            std::printf("%-32s %12.1f ns/op %10.2f allocs/op %12llu iterations\n",
+                        result.name.c_str(), result.nsPerOp, result.allocsPerOp,
+                        static_cast<unsigned long long>(result.iterations));
+            std::fflush(stdout);
+        }
+    };
+
+    const std::vector<BoardState> matchBoards = matchCorpus();
+    const std::vector<BoardState> gravityBoards = gravityCorpus();
+    const std::vector<BoardState> playableBoards = playableCorpus();
+    BoardLogic logic(1);
+
+    // Baseline for the benchmarks below that copy a board per operation
+    run("board_copy", [&](uint64_t i) {
+        BoardState state = gravityBoards[i % CORPUS_SIZE];
+        doNotOptimize(state);
+    });
+
+    // Corpus records (BoardCorpus.h) decoded into boards
+    const size_t packedSize = packedBoardSize(BoardState::CELLS);
+    std::vector<uint8_t> packed(CORPUS_SIZE * packedSize);
+    for (int i = 0; i < CORPUS_SIZE; ++i) {
+        packBoard(gravityBoards[i], packed.data() + i * packedSize);
+    }
+    BoardState unpacked;
+    run("unpack_board", [&](uint64_t i) {
+        unpackBoard(packed.data() + (i % CORPUS_SIZE) * packedSize, unpacked);
+        doNotOptimize(unpacked);
+    });
+
+    run("check_matches", [&](uint64_t i) {
+        auto result = logic.checkMatches(matchBoards[i % CORPUS_SIZE]);
+        doNotOptimize(result);
+    });
+
+    run("apply_gravity", [&](uint64_t i) {
+        BoardState state = gravityBoards[i % CORPUS_SIZE];
+        auto result = logic.applyGravity(state);
+        doNotOptimize(result);
+    });
+
+    run("has_valid_moves", [&](uint64_t i) {
+        bool found = logic.hasValidMoves(playableBoards[i % CORPUS_SIZE]);
+        doNotOptimize(found);
+    });
+
+    // Every swap of the board, as the move searcher scans it
+    run("count_valid_moves", [&](uint64_t i) {
+        int count = logic.countValidMoves(playableBoards[i % CORPUS_SIZE]);
+        doNotOptimize(count);
+    });
+
+    // A fresh board each time, since initializeBoard checks the neighbours
+    // it has not filled yet; reseeded so every iteration draws the same gems
+    BoardState initialized;
+    run("initialize_board", [&](uint64_t) {
+        initialized = BoardState{};
+        logic.seed(1);
+        logic.initializeBoard(initialized);
+        doNotOptimize(initialized);
+    });
+
+    // One move per playable board, refilled from a fixed seed so every
+    // iteration replays the same cascade
+    std::vector<Move> firstMoves;
+    std::vector<Move> moves;
+    for (const BoardState& board : playableBoards) {
+        logic.enumerateValidMoves(board, moves);
+        firstMoves.push_back(moves.empty() ? Move{} : moves.front());
+    }
+    BoardLogic::SequenceResult sequence;
+    run("execute_sequence", [&](uint64_t i) {
+        size_t index = i % CORPUS_SIZE;
+        BoardState state = playableBoards[index];
+        RandomGems<BoardState::COLORS> refills(index + 1);
+        logic.executeSequence(state, firstMoves[index], refills, sequence);
+        doNotOptimize(sequence);
+    });
+
+    return results;
+}
+
+void printJson(const BenchConfig& config, const std::vector<BenchResult>& results) {
+    std::printf("{\n");
+    std::printf("  \"corpus_size\": %d,\n", CORPUS_SIZE);
+    std::printf("  \"samples\": %d,\n", SAMPLES);
+    std::printf("  \"min_sample_ms\": %.1f,\n", config.minSampleMs);
+    std::printf("  \"simd\": \"%s\",\n", simdLevelName(simdLevel()));
+    std::printf("  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& result = results[i];
+        std::printf("    {\"name\": \"%s\", \"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"iterations\": %llu}%s\n",
+                    result.name.c_str(), result.nsPerOp, result.allocsPerOp,
+                    static_cast<unsigned long long>(result.iterations),
+                    i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+void printUsage(const char* program) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "Options:\n"
+        "  --filter TEXT   Only run benchmarks whose name contains TEXT\n"
+        "  --min-time MS   Minimum duration of one sample (default 50)\n"
+        "  --simd LEVEL    Run the board rules at LEVEL: scalar, sse2, avx2 or neon\n"
+        "                  (default: fastest supported)\n"
+        "  --json          Print results as JSON\n"
+        "  --help          Show this message\n",
+        program);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* next = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--filter") == 0 && next) {
+            config.filter = next;
+            ++i;
+        } else if (std::strcmp(arg, "--min-time") == 0 && next) {
+            char* end = nullptr;
+            config.minSampleMs = std::strtod(next, &end);
+            if (end == next || *end != '\0' || config.minSampleMs <= 0.0) {
+                std::fprintf(stderr, "Invalid value for --min-time: %s\n", next);
+                return 1;
+            }
+            ++i;
+        } else if (std::strcmp(arg, "--simd") == 0 && next) {
+            std::optional<SimdLevel> level = parseSimdLevel(next);
+            if (!level || !setSimdLevel(*level)) {
+                std::fprintf(stderr, "SIMD level not supported here: %s\n", next);
+                return 1;
+            }
+            ++i;
+        } else if (std::strcmp(arg, "--json") == 0) {
+            config.json = true;
+        } else if (std::strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n\n", arg);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!config.json) {
+        std::printf("SIMD level: %s\n", simdLevelName(simdLevel()));
+    }
+    std::vector<BenchResult> results = runBenchmarks(config);
+    if (config.json) {
+        printJson(config, results);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "AssetLoader.h"
+#include <SDL3_image/SDL_image.h>
+
+AssetLoader::AssetLoader(SDL_Renderer* renderer, unsigned threadCount)
+    : renderer(renderer)
+    , pool(threadCount) {
+}
+
+AssetLoader::~AssetLoader() {
+    pool.wait();
+    for (Decoded& item : ready) {
+        if (item.surface) {
+            SDL_DestroySurface(item.surface);
+        }
+    }
+}
+
+void AssetLoader::loadTexture(const std::string& path, TextureCallback onLoaded) {
+    ++requested;
+    pool.submit([this, path, onLoaded = std::move(onLoaded)]() mutable {
+        Decoded item{path, IMG_Load(path.c_str()), std::string(), std::move(onLoaded)};
+        if (!item.surface) {
+            // SDL errors are per thread, so capture it here
+            item.error = SDL_GetError();
+        }
+
+        std::lock_guard<std::mutex> lock(readyMutex);
+        ready.push_back(std::move(item));
+    });
+}
+
+void AssetLoader::poll() {
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        if (ready.empty()) {
+            return;
+        }
+        uploading.swap(ready);
+    }
+
+    for (Decoded& item : uploading) {
+        SDL_Texture* texture = nullptr;
+        if (item.surface) {
+            texture = SDL_CreateTextureFromSurface(renderer, item.surface);
+            if (!texture) {
+                item.error = SDL_GetError();
+            }
+            SDL_DestroySurface(item.surface);
+        }
+        if (!texture) {
+            SDL_Log("Warning: Could not load %s: %s", item.path.c_str(), item.error.c_str());
+        }
+
+        ++completed;
+        item.onLoaded(texture);
+    }
+    uploading.clear();
+}
+
+float AssetLoader::progress() const {
+    if (requested == 0) {
+        return 1.0f;
+    }
+    return static_cast<float>(completed) / static_cast<float>(requested);
+}
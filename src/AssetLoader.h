@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ThreadPool.h"
+#include <SDL3/SDL.h>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Loads images off the main thread. Files are decoded to SDL_Surface on
+// worker threads in parallel; poll(), called from the main thread once per
+// frame, uploads whatever has finished (the renderer is not thread-safe)
+// and hands each texture to its callback. Until then callers draw a
+// fallback, so startup no longer waits on PNG decoding.
+class AssetLoader {
+public:
+    // Receives the uploaded texture, which it then owns, or nullptr when the
+    // file could not be loaded
+    using TextureCallback = std::function<void(SDL_Texture*)>;
+
+    // threadCount 0 uses one thread per hardware core
+    explicit AssetLoader(SDL_Renderer* renderer, unsigned threadCount = 0);
+    // Waits for decodes in flight and frees anything never uploaded
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void loadTexture(const std::string& path, TextureCallback onLoaded);
+
+    // Uploads finished images and runs their callbacks
+    void poll();
+
+    bool isLoading() const { return completed < requested; }
+    // Fraction of requested images delivered so far, 1 when idle
+    float progress() const;
+
+private:
+    struct Decoded {
+        std::string path;
+        SDL_Surface* surface;  // Null when decoding failed
+        std::string error;
+        TextureCallback onLoaded;
+    };
+
+    SDL_Renderer* renderer;
+    size_t requested = 0;
+    size_t completed = 0;
+
+    std::mutex readyMutex;
+    std::vector<Decoded> ready;     // Filled by workers
+    std::vector<Decoded> uploading; // Swapped with ready by poll()
+
+    ThreadPool pool;  // Last, so workers stop before the queues go away
+};
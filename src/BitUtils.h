@@ -0,0 +1,39 @@
+#ifndef BITUTILS_H
+#define BITUTILS_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace BitUtils {
+
+// Number of set bits
+inline int popcount(uint64_t value) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(value));
+#else
+    return __builtin_popcountll(value);
+#endif
+}
+
+// Index of the lowest set bit. value must be non-zero.
+inline int countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+// Clear the lowest set bit
+inline uint64_t clearLowest(uint64_t value) {
+    return value & (value - 1);
+}
+
+} // namespace BitUtils
+
+#endif // BITUTILS_H
@@ -0,0 +1,141 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "BitUtils.h"
+#include <cstdint>
+#include <type_traits>
+
+// Bitboard for boards with more than 64 cells: one bit per cell spread over
+// several 64-bit words, word 0 holding cells 0-63. Bits past the last cell
+// are kept clear by every operation. Shift counts must be below 64, which
+// covers the one-row and two-row shifts the board rules use.
+template <int Cells>
+class WideBitboard {
+public:
+    static constexpr int WORDS = (Cells + 63) / 64;
+
+    constexpr WideBitboard() : words{} {}
+    constexpr WideBitboard(uint64_t low) : words{} { words[0] = low; }
+
+    static constexpr WideBitboard bit(int index) {
+        WideBitboard result;
+        result.words[index / 64] = uint64_t(1) << (index % 64);
+        return result;
+    }
+
+    constexpr uint64_t word(int i) const { return words[i]; }
+
+    // Copy with the lowest set bit cleared
+    constexpr WideBitboard withoutLowest() const {
+        WideBitboard result = *this;
+        for (int i = 0; i < WORDS; ++i) {
+            if (result.words[i]) {
+                result.words[i] &= result.words[i] - 1;
+                break;
+            }
+        }
+        return result;
+    }
+
+    constexpr WideBitboard operator&(const WideBitboard& other) const {
+        WideBitboard result;
+        for (int i = 0; i < WORDS; ++i) result.words[i] = words[i] & other.words[i];
+        return result;
+    }
+    constexpr WideBitboard operator|(const WideBitboard& other) const {
+        WideBitboard result;
+        for (int i = 0; i < WORDS; ++i) result.words[i] = words[i] | other.words[i];
+        return result;
+    }
+    constexpr WideBitboard operator^(const WideBitboard& other) const {
+        WideBitboard result;
+        for (int i = 0; i < WORDS; ++i) result.words[i] = words[i] ^ other.words[i];
+        return result;
+    }
+    constexpr WideBitboard operator~() const {
+        WideBitboard result;
+        for (int i = 0; i < WORDS; ++i) result.words[i] = ~words[i];
+        result.clearUnused();
+        return result;
+    }
+    constexpr WideBitboard operator<<(int shift) const {
+        if (shift == 0) return *this;
+        WideBitboard result;
+        for (int i = WORDS - 1; i >= 0; --i) {
+            result.words[i] = words[i] << shift;
+            if (i > 0) result.words[i] |= words[i - 1] >> (64 - shift);
+        }
+        result.clearUnused();
+        return result;
+    }
+    constexpr WideBitboard operator>>(int shift) const {
+        if (shift == 0) return *this;
+        WideBitboard result;
+        for (int i = 0; i < WORDS; ++i) {
+            result.words[i] = words[i] >> shift;
+            if (i + 1 < WORDS) result.words[i] |= words[i + 1] << (64 - shift);
+        }
+        return result;
+    }
+
+    constexpr WideBitboard& operator&=(const WideBitboard& other) { return *this = *this & other; }
+    constexpr WideBitboard& operator|=(const WideBitboard& other) { return *this = *this | other; }
+    constexpr WideBitboard& operator^=(const WideBitboard& other) { return *this = *this ^ other; }
+
+    constexpr bool operator==(const WideBitboard& other) const {
+        for (int i = 0; i < WORDS; ++i) {
+            if (words[i] != other.words[i]) return false;
+        }
+        return true;
+    }
+    constexpr bool operator!=(const WideBitboard& other) const { return !(*this == other); }
+
+    constexpr explicit operator bool() const {
+        for (int i = 0; i < WORDS; ++i) {
+            if (words[i]) return true;
+        }
+        return false;
+    }
+    constexpr bool operator!() const { return !static_cast<bool>(*this); }
+
+private:
+    uint64_t words[WORDS];
+
+    constexpr void clearUnused() {
+        if (Cells % 64 != 0) {
+            words[WORDS - 1] &= (uint64_t(1) << (Cells % 64)) - 1;
+        }
+    }
+};
+
+// Plain 64-bit integers for boards that fit, wide bitboards otherwise
+template <int Cells>
+using BitboardFor = std::conditional_t<(Cells <= 64), uint64_t, WideBitboard<Cells>>;
+
+namespace BitUtils {
+
+template <int Cells>
+inline int popcount(const WideBitboard<Cells>& value) {
+    int count = 0;
+    for (int i = 0; i < WideBitboard<Cells>::WORDS; ++i) {
+        count += popcount(value.word(i));
+    }
+    return count;
+}
+
+// value must be non-zero
+template <int Cells>
+inline int countTrailingZeros(const WideBitboard<Cells>& value) {
+    int i = 0;
+    while (!value.word(i)) ++i;
+    return i * 64 + countTrailingZeros(value.word(i));
+}
+
+template <int Cells>
+inline WideBitboard<Cells> clearLowest(const WideBitboard<Cells>& value) {
+    return value.withoutLowest();
+}
+
+} // namespace BitUtils
+
+#endif // BITBOARD_H
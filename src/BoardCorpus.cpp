@@ -0,0 +1,211 @@
+#include "BoardCorpus.h"
+#include <cstring>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIC[4] = {'M', '3', 'B', 'C'};
+const long COUNT_OFFSET = 16;
+
+void putLittle(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint64_t getLittle(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+size_t recordSizeFor(int rows, int cols, bool withScores) {
+    return packedBoardSize(rows * cols) + (withScores ? 4 : 0);
+}
+
+} // namespace
+
+BoardCorpusWriter::~BoardCorpusWriter() {
+    close();
+}
+
+bool BoardCorpusWriter::open(const std::string& path, int rows, int cols, int colors, bool withScores) {
+    close();
+    if (rows <= 0 || cols <= 0 || rows > 255 || cols > 255 || colors <= 0 ||
+        colors > static_cast<int>(GemType::COUNT)) {
+        return false;
+    }
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    this->rows = rows;
+    this->cols = cols;
+    this->colors = colors;
+    this->withScores = withScores;
+    failed = false;
+    count = 0;
+    record.assign(packedBoardSize(rows * cols), 0);
+
+    // The count is filled in by close()
+    uint8_t header[BOARD_CORPUS_HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    putLittle(header + 4, BOARD_CORPUS_VERSION, 2);
+    header[6] = static_cast<uint8_t>(rows);
+    header[7] = static_cast<uint8_t>(cols);
+    header[8] = static_cast<uint8_t>(colors);
+    header[9] = withScores ? BOARD_CORPUS_SCORES : 0;
+    putLittle(header + 10, recordSizeFor(rows, cols, withScores), 2);
+    failed = std::fwrite(header, sizeof(header), 1, file) != 1;
+    return !failed;
+}
+
+bool BoardCorpusWriter::writeRecord(int score) {
+    bool written = std::fwrite(record.data(), record.size(), 1, file) == 1;
+    if (written && withScores) {
+        uint8_t bytes[4];
+        putLittle(bytes, static_cast<uint32_t>(score), 4);
+        written = std::fwrite(bytes, sizeof(bytes), 1, file) == 1;
+    }
+    if (!written) {
+        failed = true;
+        return false;
+    }
+    ++count;
+    return true;
+}
+
+bool BoardCorpusWriter::close() {
+    if (!file) {
+        return false;
+    }
+
+    uint8_t bytes[8];
+    putLittle(bytes, count, 8);
+    if (std::fseek(file, COUNT_OFFSET, SEEK_SET) != 0 || std::fwrite(bytes, sizeof(bytes), 1, file) != 1) {
+        failed = true;
+    }
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
+
+int PackedBoard::score() const {
+    if (!hasScore) {
+        return 0;
+    }
+    return static_cast<int32_t>(getLittle(bytes + packedBoardSize(rows * cols), 4));
+}
+
+MappedBoardCorpus::~MappedBoardCorpus() {
+    close();
+}
+
+bool MappedBoardCorpus::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(BOARD_CORPUS_HEADER_SIZE)) {
+        close();
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+    mapping = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    mappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size < static_cast<off_t>(BOARD_CORPUS_HEADER_SIZE)) {
+        ::close(file);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps the file alive
+    ::close(file);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    // Corpora are mostly read front to back
+    madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    mapping = static_cast<const uint8_t*>(view);
+    mappingSize = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!mapping || !readHeader()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedBoardCorpus::readHeader() {
+    if (std::memcmp(mapping, MAGIC, sizeof(MAGIC)) != 0 ||
+        getLittle(mapping + 4, 2) != BOARD_CORPUS_VERSION) {
+        return false;
+    }
+    rows = mapping[6];
+    cols = mapping[7];
+    colors = mapping[8];
+    withScores = (mapping[9] & BOARD_CORPUS_SCORES) != 0;
+    recordSize = static_cast<size_t>(getLittle(mapping + 10, 2));
+    count = getLittle(mapping + COUNT_OFFSET, 8);
+
+    if (rows == 0 || cols == 0 || recordSize != recordSizeFor(rows, cols, withScores)) {
+        return false;
+    }
+    // Written by an unfinished writer, or truncated
+    uint64_t available = (mappingSize - BOARD_CORPUS_HEADER_SIZE) / recordSize;
+    return count == available && BOARD_CORPUS_HEADER_SIZE + count * recordSize == mappingSize;
+}
+
+void MappedBoardCorpus::close() {
+#ifdef _WIN32
+    if (mapping) {
+        UnmapViewOfFile(mapping);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+        fileHandle = nullptr;
+    }
+#else
+    if (mapping) {
+        munmap(const_cast<uint8_t*>(mapping), mappingSize);
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    count = 0;
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "BoardTypes.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Binary corpus of boards for tools and tests, about 3 bits per cell:
+//
+//   Header, 32 bytes, little-endian:
+//     "M3BC"          magic
+//     u16 version     BOARD_CORPUS_VERSION
+//     u8 rows, u8 cols, u8 colors
+//     u8 flags        BOARD_CORPUS_SCORES: records end with an i32 score
+//     u16 recordSize  bytes per board
+//     u32 reserved    0
+//     u64 boardCount
+//     u64 reserved    0
+//   boardCount fixed-size records
+//
+// A record packs the cells in row-major order, eight cells to three bytes:
+// cell i of a group sits in bits 3i..3i+2 of the group's little-endian
+// 24 bits, holding the GemType value (EMPTY is 7). The last group is padded
+// with EMPTY. An 8x8 board takes 24 bytes.
+//
+// Records have a fixed size, so board i of a memory-mapped file is read in
+// place, without parsing the boards before it.
+constexpr uint16_t BOARD_CORPUS_VERSION = 1;
+constexpr uint8_t BOARD_CORPUS_SCORES = 1;
+
+constexpr size_t BOARD_CORPUS_HEADER_SIZE = 32;
+
+constexpr size_t packedBoardSize(int cells) {
+    return static_cast<size_t>((cells + 7) / 8) * 3;
+}
+
+inline GemType packedCell(const uint8_t* data, int cell) {
+    const uint8_t* group = data + (cell / 8) * 3;
+    uint32_t bits = group[0] | (group[1] << 8) | (group[2] << 16);
+    return static_cast<GemType>((bits >> (3 * (cell % 8))) & 7);
+}
+
+template <typename State>
+void packBoard(const State& state, uint8_t* out) {
+    for (int first = 0; first < State::CELLS; first += 8) {
+        uint32_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            int cell = first + i;
+            GemType type = cell < State::CELLS ? state.at(cell / State::COLS, cell % State::COLS) : GemType::EMPTY;
+            if (!State::isGem(type)) type = GemType::EMPTY;
+            bits |= static_cast<uint32_t>(type) << (3 * i);
+        }
+        *out++ = static_cast<uint8_t>(bits);
+        *out++ = static_cast<uint8_t>(bits >> 8);
+        *out++ = static_cast<uint8_t>(bits >> 16);
+    }
+}
+
+// Cells holding anything but a gem of State's colors come back EMPTY
+template <typename State>
+void unpackBoard(const uint8_t* data, State& state) {
+    for (int first = 0; first < State::CELLS; first += 8) {
+        uint32_t bits = data[0] | (data[1] << 8) | (data[2] << 16);
+        data += 3;
+        for (int i = 0; i < 8 && first + i < State::CELLS; ++i) {
+            GemType type = static_cast<GemType>((bits >> (3 * i)) & 7);
+            int cell = first + i;
+            state.at(cell / State::COLS, cell % State::COLS) = State::isGem(type) ? type : GemType::EMPTY;
+        }
+    }
+}
+
+// Appends boards of one shape to a corpus file
+class BoardCorpusWriter {
+public:
+    BoardCorpusWriter() = default;
+    ~BoardCorpusWriter();
+
+    BoardCorpusWriter(const BoardCorpusWriter&) = delete;
+    BoardCorpusWriter& operator=(const BoardCorpusWriter&) = delete;
+
+    // withScores stores each board's score after its cells
+    bool open(const std::string& path, int rows, int cols, int colors, bool withScores = false);
+
+    // False when the board's shape differs from the corpus or writing fails
+    template <typename State>
+    bool write(const State& state) {
+        if (!file || State::ROWS != rows || State::COLS != cols || State::COLORS != colors) {
+            return false;
+        }
+        packBoard(state, record.data());
+        return writeRecord(state.score);
+    }
+
+    // Writes the board count into the header. False if anything failed
+    // since open().
+    bool close();
+
+    uint64_t size() const { return count; }
+
+private:
+    FILE* file = nullptr;
+    int rows = 0;
+    int cols = 0;
+    int colors = 0;
+    bool withScores = false;
+    bool failed = false;
+    uint64_t count = 0;
+    std::vector<uint8_t> record;  // Packed cells of the board being written
+
+    bool writeRecord(int score);
+};
+
+// One board of a mapped corpus, read in place
+class PackedBoard {
+public:
+    PackedBoard(const uint8_t* data, int rows, int cols, int colors, bool hasScore)
+        : bytes(data), rows(rows), cols(cols), colors(colors), hasScore(hasScore) {}
+
+    GemType at(int row, int col) const { return packedCell(bytes, row * cols + col); }
+    int score() const;  // 0 when the corpus has no scores
+
+    // False when State's shape differs from the corpus
+    template <typename State>
+    bool unpack(State& state) const {
+        if (State::ROWS != rows || State::COLS != cols || State::COLORS != colors) {
+            return false;
+        }
+        unpackBoard(bytes, state);
+        state.score = score();
+        return true;
+    }
+
+    const uint8_t* data() const { return bytes; }
+
+private:
+    const uint8_t* bytes;
+    int rows;
+    int cols;
+    int colors;
+    bool hasScore;
+};
+
+// Read-only corpus file mapped into memory. Boards are decoded only when
+// asked for, so opening costs the same for any corpus size and memory use
+// is whatever the OS pages in.
+class MappedBoardCorpus {
+public:
+    class Iterator {
+    public:
+        Iterator(const MappedBoardCorpus* corpus, uint64_t index) : corpus(corpus), index(index) {}
+
+        PackedBoard operator*() const { return (*corpus)[index]; }
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+    private:
+        const MappedBoardCorpus* corpus;
+        uint64_t index;
+    };
+
+    MappedBoardCorpus() = default;
+    ~MappedBoardCorpus();
+
+    MappedBoardCorpus(const MappedBoardCorpus&) = delete;
+    MappedBoardCorpus& operator=(const MappedBoardCorpus&) = delete;
+
+    // False when the file cannot be mapped or is not a complete corpus
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    uint64_t size() const { return count; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getColors() const { return colors; }
+    bool hasScores() const { return withScores; }
+
+    PackedBoard operator[](uint64_t index) const {
+        return PackedBoard(mapping + BOARD_CORPUS_HEADER_SIZE + index * recordSize, rows, cols, colors, withScores);
+    }
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, count); }
+
+private:
+    const uint8_t* mapping = nullptr;
+    size_t mappingSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    int rows = 0;
+    int cols = 0;
+    int colors = 0;
+    bool withScores = false;
+    size_t recordSize = 0;
+    uint64_t count = 0;
+
+    bool readHeader();
+};
@@ -0,0 +1,273 @@
+#pragma once
+
+// Bitboard rules shared by BoardLogic.cpp and BoardLogicAvx2.cpp; not part
+// of the public interface.
+//
+// The rules are templates over the mask type. With State::Mask they work on
+// one color's bitboard; with a lane type below they work on several colors'
+// 64-bit bitboards at once, one per vector lane, with the same shifts and
+// masks.
+
+#include "BoardTypes.h"
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MATCH3_SSE2_LANES 1
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MATCH3_NEON_LANES 1
+#endif
+
+namespace BoardKernels {
+
+// Column masks and strides for one board shape
+template <typename State>
+struct BoardMasks {
+    using Mask = typename State::Mask;
+
+    // Cells where a horizontal run of three can start without wrapping rows
+    static constexpr Mask horizontalRunStarts() {
+        Mask mask{};
+        for (int col = 0; col + 2 < State::COLS; ++col) {
+            mask |= State::columnMask(col);
+        }
+        return mask;
+    }
+
+    static constexpr int ROW_STRIDE = State::COLS;
+    static constexpr Mask HORIZONTAL_RUN_STARTS = horizontalRunStarts();
+    static constexpr Mask NOT_FIRST_COLUMN = ~State::columnMask(0);
+    static constexpr Mask NOT_LAST_COLUMN = ~State::columnMask(State::COLS - 1);
+    static constexpr Mask AFTER_SECOND_COLUMN = ~(State::columnMask(0) | State::columnMask(1));
+    static constexpr Mask INNER_COLUMNS = NOT_FIRST_COLUMN & NOT_LAST_COLUMN;
+};
+
+template <typename Mask>
+struct SwapMaskPair {
+    Mask horizontal{};  // Bit a: swapping a and a + 1 is valid
+    Mask vertical{};    // Bit a: swapping a and a + COLS is valid
+};
+
+// Vector kernels need one 64-bit lane per color
+template <typename State>
+constexpr bool LANE_MASKS = std::is_same<typename State::Mask, uint64_t>::value;
+
+// One instruction set's kernels for one board shape
+struct LaneKernels {
+    uint64_t (*matchMask)(const uint64_t* colorMasks);
+    bool (*hasSwaps)(const uint64_t* colorMasks, uint64_t occupied);
+    SwapMaskPair<uint64_t> (*validSwapMasks)(const uint64_t* colorMasks, uint64_t occupied);
+};
+
+// Defined in BoardLogicAvx2.cpp for every shape in MATCH3_BOARD_SHAPES.
+// Null when the shape needs wide bitboards or that file was built without
+// AVX2.
+template <typename State>
+const LaneKernels* avx2Kernels();
+
+// Whether BoardLogicAvx2.cpp was built with AVX2
+bool avx2Built();
+
+// The functions below have internal linkage: each file gets its own copies,
+// inlined into its callers, and the ones compiled for AVX2 never replace
+// another file's at link time.
+namespace {
+
+// Cells of one color that are part of a horizontal or vertical run of three
+template <typename State, typename Mask = typename State::Mask>
+inline Mask colorMatchMask(Mask gems) {
+    using M = BoardMasks<State>;
+
+    // A bit survives if the next two cells along the line share its color
+    const Mask horizontal = gems & (gems >> 1) & (gems >> 2) & M::HORIZONTAL_RUN_STARTS;
+    const Mask vertical = gems & (gems >> M::ROW_STRIDE) & (gems >> (2 * M::ROW_STRIDE));
+
+    return horizontal | (horizontal << 1) | (horizontal << 2) |
+           vertical | (vertical << M::ROW_STRIDE) | (vertical << (2 * M::ROW_STRIDE));
+}
+
+// Swaps that move a gem of one color into a cell where it completes a run.
+// Each move template is "two cells of that color next to the target",
+// leaving out the side the gem arrives from, since that cell now holds the
+// other swapped gem.
+template <typename State, typename SwapMasks, typename Mask = typename State::Mask>
+inline SwapMasks colorSwapMasks(Mask gems, Mask occupied) {
+    using M = BoardMasks<State>;
+    constexpr int ROW_STRIDE = M::ROW_STRIDE;
+
+    // Targets with a same-colored pair to the left, right, around, etc.
+    const Mask left = (gems << 1) & (gems << 2) & M::AFTER_SECOND_COLUMN;
+    const Mask right = (gems >> 1) & (gems >> 2) & M::HORIZONTAL_RUN_STARTS;
+    const Mask leftRight = (gems << 1) & (gems >> 1) & M::INNER_COLUMNS;
+    const Mask up = (gems << ROW_STRIDE) & (gems << (2 * ROW_STRIDE));
+    const Mask down = (gems >> ROW_STRIDE) & (gems >> (2 * ROW_STRIDE));
+    const Mask upDown = (gems << ROW_STRIDE) & (gems >> ROW_STRIDE);
+
+    // Only other occupied cells can receive this color
+    const Mask targets = occupied & ~gems;
+
+    SwapMasks masks;
+    // Gem moves left from a + 1 into a, or right from a into a + 1
+    masks.horizontal = ((left | up | down | upDown) & (gems >> 1) & M::NOT_LAST_COLUMN & targets) |
+                       (((right | up | down | upDown) & (gems << 1) & M::NOT_FIRST_COLUMN & targets) >> 1);
+    // Gem moves up from a + COLS into a, or down from a into a + COLS
+    masks.vertical = ((left | right | leftRight | up) & (gems >> ROW_STRIDE) & targets) |
+                     (((left | right | leftRight | down) & (gems << ROW_STRIDE) & targets) >> ROW_STRIDE);
+    return masks;
+}
+
+// Lane types: WIDTH colors' bitboards in one register, with the bitwise
+// operators and shifts the rules above use. Shifts move bits within each
+// lane. load() fills lanes past `count` with zero, an absent color that
+// matches nothing and completes no swap.
+
+#if MATCH3_SSE2_LANES
+struct Sse2Lanes {
+    static constexpr int WIDTH = 2;
+    __m128i bits;
+
+    static Sse2Lanes load(const uint64_t* masks, int count) {
+        if (count >= WIDTH) {
+            return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks))};
+        }
+        return {_mm_loadl_epi64(reinterpret_cast<const __m128i*>(masks))};
+    }
+    static Sse2Lanes broadcast(uint64_t mask) { return {_mm_set1_epi64x(static_cast<long long>(mask))}; }
+
+    // OR of every lane
+    uint64_t combined() const {
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_or_si128(bits, _mm_unpackhi_epi64(bits, bits))));
+    }
+    bool any() const { return combined() != 0; }
+};
+
+inline Sse2Lanes operator&(Sse2Lanes a, Sse2Lanes b) { return {_mm_and_si128(a.bits, b.bits)}; }
+inline Sse2Lanes operator&(Sse2Lanes a, uint64_t b) { return a & Sse2Lanes::broadcast(b); }
+inline Sse2Lanes operator|(Sse2Lanes a, Sse2Lanes b) { return {_mm_or_si128(a.bits, b.bits)}; }
+inline Sse2Lanes operator~(Sse2Lanes a) { return {_mm_xor_si128(a.bits, _mm_set1_epi32(-1))}; }
+inline Sse2Lanes operator<<(Sse2Lanes a, int n) { return {_mm_sll_epi64(a.bits, _mm_cvtsi32_si128(n))}; }
+inline Sse2Lanes operator>>(Sse2Lanes a, int n) { return {_mm_srl_epi64(a.bits, _mm_cvtsi32_si128(n))}; }
+#endif
+
+// Only BoardLogicAvx2.cpp is compiled with AVX2 enabled
+#if defined(__AVX2__)
+struct Avx2Lanes {
+    static constexpr int WIDTH = 4;
+    __m256i bits;
+
+    static Avx2Lanes load(const uint64_t* masks, int count) {
+        if (count >= WIDTH) {
+            return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks))};
+        }
+        const __m256i wanted = _mm256_cmpgt_epi64(_mm256_set1_epi64x(count), _mm256_setr_epi64x(0, 1, 2, 3));
+        return {_mm256_maskload_epi64(reinterpret_cast<const long long*>(masks), wanted)};
+    }
+    static Avx2Lanes broadcast(uint64_t mask) { return {_mm256_set1_epi64x(static_cast<long long>(mask))}; }
+
+    uint64_t combined() const {
+        __m128i half = _mm_or_si128(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1));
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_or_si128(half, _mm_unpackhi_epi64(half, half))));
+    }
+    bool any() const { return !_mm256_testz_si256(bits, bits); }
+};
+
+inline Avx2Lanes operator&(Avx2Lanes a, Avx2Lanes b) { return {_mm256_and_si256(a.bits, b.bits)}; }
+inline Avx2Lanes operator&(Avx2Lanes a, uint64_t b) { return a & Avx2Lanes::broadcast(b); }
+inline Avx2Lanes operator|(Avx2Lanes a, Avx2Lanes b) { return {_mm256_or_si256(a.bits, b.bits)}; }
+inline Avx2Lanes operator~(Avx2Lanes a) { return {_mm256_xor_si256(a.bits, _mm256_set1_epi32(-1))}; }
+inline Avx2Lanes operator<<(Avx2Lanes a, int n) { return {_mm256_sll_epi64(a.bits, _mm_cvtsi32_si128(n))}; }
+inline Avx2Lanes operator>>(Avx2Lanes a, int n) { return {_mm256_srl_epi64(a.bits, _mm_cvtsi32_si128(n))}; }
+#endif
+
+#if MATCH3_NEON_LANES
+struct NeonLanes {
+    static constexpr int WIDTH = 2;
+    uint64x2_t bits;
+
+    static NeonLanes load(const uint64_t* masks, int count) {
+        if (count >= WIDTH) {
+            return {vld1q_u64(masks)};
+        }
+        return {vcombine_u64(vld1_u64(masks), vcreate_u64(0))};
+    }
+    static NeonLanes broadcast(uint64_t mask) { return {vdupq_n_u64(mask)}; }
+
+    uint64_t combined() const { return vgetq_lane_u64(bits, 0) | vgetq_lane_u64(bits, 1); }
+    bool any() const { return combined() != 0; }
+};
+
+inline NeonLanes operator&(NeonLanes a, NeonLanes b) { return {vandq_u64(a.bits, b.bits)}; }
+inline NeonLanes operator&(NeonLanes a, uint64_t b) { return a & NeonLanes::broadcast(b); }
+inline NeonLanes operator|(NeonLanes a, NeonLanes b) { return {vorrq_u64(a.bits, b.bits)}; }
+inline NeonLanes operator~(NeonLanes a) { return {veorq_u64(a.bits, vdupq_n_u64(~0ull))}; }
+// NEON shifts right by shifting left a negative amount
+inline NeonLanes operator<<(NeonLanes a, int n) { return {vshlq_u64(a.bits, vdupq_n_s64(n))}; }
+inline NeonLanes operator>>(NeonLanes a, int n) { return {vshlq_u64(a.bits, vdupq_n_s64(-n))}; }
+#endif
+
+// The rules for every color of a board, Lanes::WIDTH colors per step.
+// colorMasks holds State::COLORS bitboards in GemType order.
+
+template <typename State, typename Lanes>
+uint64_t laneMatchMask(const uint64_t* colorMasks) {
+    Lanes matched = Lanes::broadcast(0);
+    for (int first = 0; first < State::COLORS; first += Lanes::WIDTH) {
+        matched = matched | colorMatchMask<State>(Lanes::load(colorMasks + first, State::COLORS - first));
+    }
+    return matched.combined();
+}
+
+// Stops at the first group of colors with a swap, as the scalar loop stops
+// at the first color
+template <typename State, typename Lanes>
+bool laneHasSwaps(const uint64_t* colorMasks, uint64_t occupied) {
+    const Lanes cells = Lanes::broadcast(occupied);
+    for (int first = 0; first < State::COLORS; first += Lanes::WIDTH) {
+        auto masks = colorSwapMasks<State, SwapMaskPair<Lanes>>(
+            Lanes::load(colorMasks + first, State::COLORS - first), cells);
+        if ((masks.horizontal | masks.vertical).any()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// All valid swaps, as BasicBoardLogic::validSwapMasks: swaps that complete
+// a run, plus swaps of two same-colored gems where one is already matched.
+// Each group of colors is loaded once for the runs, pairs and swaps.
+template <typename State, typename Lanes>
+SwapMaskPair<uint64_t> laneValidSwapMasks(const uint64_t* colorMasks, uint64_t occupied) {
+    using M = BoardMasks<State>;
+    const Lanes none = Lanes::broadcast(0);
+    const Lanes cells = Lanes::broadcast(occupied);
+    Lanes matched = none;
+    SwapMaskPair<Lanes> swaps{none, none};
+    SwapMaskPair<Lanes> pairs{none, none};
+    for (int first = 0; first < State::COLORS; first += Lanes::WIDTH) {
+        const Lanes gems = Lanes::load(colorMasks + first, State::COLORS - first);
+        matched = matched | colorMatchMask<State>(gems);
+        auto masks = colorSwapMasks<State, SwapMaskPair<Lanes>>(gems, cells);
+        swaps.horizontal = swaps.horizontal | masks.horizontal;
+        swaps.vertical = swaps.vertical | masks.vertical;
+        pairs.horizontal = pairs.horizontal | (gems & (gems >> 1) & M::NOT_LAST_COLUMN);
+        pairs.vertical = pairs.vertical | (gems & (gems >> M::ROW_STRIDE));
+    }
+
+    const uint64_t runs = matched.combined();
+    return {swaps.horizontal.combined() | (pairs.horizontal.combined() & (runs | (runs >> 1))),
+            swaps.vertical.combined() | (pairs.vertical.combined() & (runs | (runs >> M::ROW_STRIDE)))};
+}
+
+template <typename State, typename Lanes>
+constexpr LaneKernels makeLaneKernels() {
+    return {&laneMatchMask<State, Lanes>, &laneHasSwaps<State, Lanes>, &laneValidSwapMasks<State, Lanes>};
+}
+
+} // namespace
+
+} // namespace BoardKernels
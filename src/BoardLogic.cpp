@@ -1,105 +1,179 @@
 #include "BoardLogic.h"
+#include "BitUtils.h"
+#include "BoardKernels.h"
+#include "SimdLevel.h"
 #include <random>
-#include <set>
 #include <algorithm>
+#include <array>
 
-BoardLogic::BoardLogic(GemFactory factory) : gemFactory(factory) {
-    if (!gemFactory) {
-        gemFactory = [this](int, int) {
-            return getRandomGemType();
-        };
-    }
+template <int Rows, int Cols, int Colors>
+BasicBoardLogic<Rows, Cols, Colors>::BasicBoardLogic(GemFactory factory)
+    : gemFactory(std::move(factory))
+    , rng((static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}()) {
 }
 
-GemType BoardLogic::getRandomGemType() const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, static_cast<int>(GemType::COUNT) - 1);
-    return static_cast<GemType>(dis(gen));
+template <int Rows, int Cols, int Colors>
+BasicBoardLogic<Rows, Cols, Colors>::BasicBoardLogic(uint64_t seed) : rng(seed) {
 }
 
-void BoardLogic::initializeBoard(BoardState& state) const {
-    for (int row = 0; row < BoardState::ROWS; ++row) {
-        for (int col = 0; col < BoardState::COLS; ++col) {
-            GemType type;
-            do {
-                type = gemFactory(row, col);
-            } while (wouldCreateMatch(state, row, col, type));
-            state.at(row, col) = type;
+template <int Rows, int Cols, int Colors>
+void BasicBoardLogic<Rows, Cols, Colors>::generateGems(GemType* out, int count) const {
+    // Each 64-bit step gives two 32-bit lanes. A lane maps to a color by
+    // multiply-shift; the few lane values that would bias it are rejected.
+    constexpr uint32_t REJECT_BELOW = (0u - static_cast<uint32_t>(Colors)) % Colors;
+    int written = 0;
+    while (written < count) {
+        uint64_t bits = rng();
+        for (int lane = 0; lane < 2 && written < count; ++lane, bits >>= 32) {
+            uint64_t product = (bits & 0xFFFFFFFFull) * Colors;
+            if (static_cast<uint32_t>(product) >= REJECT_BELOW) {
+                out[written++] = static_cast<GemType>(product >> 32);
+            }
         }
     }
 }
 
-MatchResult BoardLogic::checkMatches(const BoardState& state) const {
-    MatchResult result;
-    std::set<Position> uniqueMatches;
+template <int Rows, int Cols, int Colors>
+void BasicBoardLogic<Rows, Cols, Colors>::initializeBoard(State& state) const {
+    if (gemFactory) {
+        initializeBoard(state, gemFactory);
+        return;
+    }
+    initializeBoard(state, [this](int, int) { return static_cast<GemType>(rng.below(Colors)); });
+}
 
-    for (int row = 0; row < BoardState::ROWS; ++row) {
-        for (int col = 0; col < BoardState::COLS; ++col) {
-            if (state.at(row, col) == GemType::EMPTY) continue;
+namespace {
+
+using BoardKernels::BoardMasks;
+using BoardKernels::colorMatchMask;
+using BoardKernels::colorSwapMasks;
+
+// Expand seed cells to the whole horizontal runs in `runs` that contain them
+template <typename State, typename Mask = typename State::Mask>
+Mask growHorizontal(Mask seeds, Mask runs) {
+    using M = BoardMasks<State>;
+    Mask grown = seeds;
+    do {
+        seeds = grown;
+        grown |= ((seeds << 1) & M::NOT_FIRST_COLUMN & runs) |
+                 ((seeds >> 1) & M::NOT_LAST_COLUMN & runs);
+    } while (grown != seeds);
+    return grown;
+}
 
-            std::vector<Position> horizontal, vertical;
-            findHorizontalMatches(state, row, col, horizontal);
-            findVerticalMatches(state, row, col, vertical);
+// Expand seed cells to the whole vertical runs in `runs` that contain them
+template <typename State, typename Mask = typename State::Mask>
+Mask growVertical(Mask seeds, Mask runs) {
+    using M = BoardMasks<State>;
+    Mask grown = seeds;
+    do {
+        seeds = grown;
+        grown |= ((seeds << M::ROW_STRIDE) | (seeds >> M::ROW_STRIDE)) & runs;
+    } while (grown != seeds);
+    return grown;
+}
 
-            if (horizontal.size() >= 3) {
-                for (const auto& pos : horizontal) {
-                    uniqueMatches.insert(pos);
-                }
-            }
-            if (vertical.size() >= 3) {
-                for (const auto& pos : vertical) {
-                    uniqueMatches.insert(pos);
-                }
-            }
+// Vector kernels for the current SimdLevel, or null to run the scalar loops
+template <typename State>
+const BoardKernels::LaneKernels* activeLaneKernels() {
+    switch (simdLevel()) {
+        case SimdLevel::AVX2:
+            return BoardKernels::avx2Kernels<State>();
+#if MATCH3_SSE2_LANES
+        case SimdLevel::SSE2: {
+            static constexpr BoardKernels::LaneKernels kernels =
+                BoardKernels::makeLaneKernels<State, BoardKernels::Sse2Lanes>();
+            return &kernels;
+        }
+#endif
+#if MATCH3_NEON_LANES
+        case SimdLevel::NEON: {
+            static constexpr BoardKernels::LaneKernels kernels =
+                BoardKernels::makeLaneKernels<State, BoardKernels::NeonLanes>();
+            return &kernels;
         }
+#endif
+        default:
+            return nullptr;
     }
+}
 
-    for (const auto& pos : uniqueMatches) {
-        result.matchedPositions.push_back(pos);
-        result.score += 10;
-    }
+} // namespace
 
-    return result;
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::MatchResult
+BasicBoardLogic<Rows, Cols, Colors>::checkMatches(const State& state) const {
+    return toMatchResult(findMatchMask(state));
 }
 
-void BoardLogic::findHorizontalMatches(const BoardState& state, int row, int col,
-                                       std::vector<Position>& matches) const {
-    if (state.at(row, col) == GemType::EMPTY) return;
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::MatchResult
+BasicBoardLogic<Rows, Cols, Colors>::checkMatches(const State& state, Mask dirty) const {
+    return toMatchResult(findMatchMask(state, dirty));
+}
 
-    GemType type = state.at(row, col);
-    matches.clear();
-    matches.push_back({row, col});
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::MatchResult
+BasicBoardLogic<Rows, Cols, Colors>::toMatchResult(Mask matched) const {
+    MatchResult result;
 
-    // Check left
-    for (int c = col - 1; c >= 0 && state.at(row, c) == type; --c) {
-        matches.push_back({row, c});
+    // Bit order is row-major, so walking set bits yields sorted positions
+    for (; matched; matched = BitUtils::clearLowest(matched)) {
+        int index = BitUtils::countTrailingZeros(matched);
+        result.matchedPositions.push_back({index / State::COLS, index % State::COLS});
     }
-    // Check right
-    for (int c = col + 1; c < BoardState::COLS && state.at(row, c) == type; ++c) {
-        matches.push_back({row, c});
+    result.score = static_cast<int>(result.matchedPositions.size()) * 10;
+
+    return result;
+}
+
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::Mask
+BasicBoardLogic<Rows, Cols, Colors>::findMatchMask(const State& state) const {
+    if constexpr (BoardKernels::LANE_MASKS<State>) {
+        if (const BoardKernels::LaneKernels* kernels = activeLaneKernels<State>()) {
+            return kernels->matchMask(state.colorMaskData());
+        }
     }
+
+    Mask matched{};
+    for (int i = 0; i < Colors; ++i) {
+        matched |= colorMatchMask<State>(state.mask(static_cast<GemType>(i)));
+    }
+    return matched;
 }
 
-void BoardLogic::findVerticalMatches(const BoardState& state, int row, int col,
-                                     std::vector<Position>& matches) const {
-    if (state.at(row, col) == GemType::EMPTY) return;
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::Mask
+BasicBoardLogic<Rows, Cols, Colors>::findMatchMask(const State& state, Mask dirty) const {
+    using M = BoardMasks<State>;
+    Mask matched{};
 
-    GemType type = state.at(row, col);
-    matches.clear();
-    matches.push_back({row, col});
+    for (int i = 0; i < Colors; ++i) {
+        const Mask gems = state.mask(static_cast<GemType>(i));
 
-    // Check up
-    for (int r = row - 1; r >= 0 && state.at(r, col) == type; --r) {
-        matches.push_back({r, col});
-    }
-    // Check down
-    for (int r = row + 1; r < BoardState::ROWS && state.at(r, col) == type; ++r) {
-        matches.push_back({r, col});
+        // A new run of this color must contain a dirty cell of this color
+        const Mask seeds = gems & dirty;
+        if (!seeds) continue;
+
+        Mask horizontal = gems & (gems >> 1) & (gems >> 2) & M::HORIZONTAL_RUN_STARTS;
+        Mask vertical = gems & (gems >> M::ROW_STRIDE) & (gems >> (2 * M::ROW_STRIDE));
+        horizontal |= (horizontal << 1) | (horizontal << 2);
+        vertical |= (vertical << M::ROW_STRIDE) | (vertical << (2 * M::ROW_STRIDE));
+
+        if (seeds & horizontal) {
+            matched |= growHorizontal<State>(seeds & horizontal, horizontal);
+        }
+        if (seeds & vertical) {
+            matched |= growVertical<State>(seeds & vertical, vertical);
+        }
     }
+
+    return matched;
 }
 
-void BoardLogic::removeMatches(BoardState& state, const std::vector<Position>& positions) const {
+template <int Rows, int Cols, int Colors>
+void BasicBoardLogic<Rows, Cols, Colors>::removeMatches(State& state, PositionSpan positions) const {
     for (const auto& pos : positions) {
         if (state.isValid(pos.row, pos.col)) {
             state.at(pos.row, pos.col) = GemType::EMPTY;
@@ -107,17 +181,24 @@ void BoardLogic::removeMatches(BoardState& state, const std::vector<Position>& p
     }
 }
 
-GravityResult BoardLogic::applyGravity(BoardState& state) const {
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::GravityResult
+BasicBoardLogic<Rows, Cols, Colors>::applyGravity(State& state) const {
     GravityResult result;
 
-    for (int col = 0; col < BoardState::COLS; ++col) {
-        int writeRow = BoardState::ROWS - 1;
+    for (int col = 0; col < State::COLS; ++col) {
+        // Full columns have nothing to fall into
+        const Mask column = State::columnMask(col);
+        if ((state.occupied() & column) == column) continue;
+
+        int writeRow = State::ROWS - 1;
 
         // Move existing gems down
-        for (int row = BoardState::ROWS - 1; row >= 0; --row) {
+        for (int row = State::ROWS - 1; row >= 0; --row) {
             if (state.at(row, col) != GemType::EMPTY) {
                 if (row != writeRow) {
                     result.moves.push_back({{row, col}, {writeRow, col}});
+                    result.dirty |= State::bit(writeRow, col);
                     state.at(writeRow, col) = state.at(row, col);
                     state.at(row, col) = GemType::EMPTY;
                 }
@@ -134,15 +215,37 @@ GravityResult BoardLogic::applyGravity(BoardState& state) const {
     return result;
 }
 
-void BoardLogic::fillEmpty(BoardState& state, const std::vector<Position>& positions) const {
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::Mask
+BasicBoardLogic<Rows, Cols, Colors>::fillEmpty(State& state, PositionSpan positions) const {
+    if (gemFactory) {
+        return fillEmpty(state, positions, gemFactory);
+    }
+
+    // Draw all refills in one bulk call, then place them in position order
+    std::array<GemType, State::CELLS> gems;
+    Mask filled{};
+    int count = 0;
     for (const auto& pos : positions) {
-        if (state.isValid(pos.row, pos.col) && state.at(pos.row, pos.col) == GemType::EMPTY) {
-            state.at(pos.row, pos.col) = gemFactory(pos.row, pos.col);
+        if (state.isValid(pos.row, pos.col) && state.at(pos.row, pos.col) == GemType::EMPTY &&
+            !(filled & State::bit(pos.row, pos.col))) {
+            filled |= State::bit(pos.row, pos.col);
+            ++count;
         }
     }
+    generateGems(gems.data(), count);
+
+    int next = 0;
+    for (const auto& pos : positions) {
+        if (next < count && state.isValid(pos.row, pos.col) && state.at(pos.row, pos.col) == GemType::EMPTY) {
+            state.at(pos.row, pos.col) = gems[next++];
+        }
+    }
+    return filled;
 }
 
-bool BoardLogic::isValidSwap(const BoardState& state, const Move& move) const {
+template <int Rows, int Cols, int Colors>
+bool BasicBoardLogic<Rows, Cols, Colors>::isValidSwap(const State& state, const Move& move) const {
     if (!state.isValid(move.from.row, move.from.col)) return false;
     if (!state.isValid(move.to.row, move.to.col)) return false;
     if (state.at(move.from.row, move.from.col) == GemType::EMPTY) return false;
@@ -150,13 +253,15 @@ bool BoardLogic::isValidSwap(const BoardState& state, const Move& move) const {
     return areAdjacent(move.from, move.to);
 }
 
-bool BoardLogic::areAdjacent(const Position& a, const Position& b) const {
+template <int Rows, int Cols, int Colors>
+bool BasicBoardLogic<Rows, Cols, Colors>::areAdjacent(const Position& a, const Position& b) const {
     int rowDiff = std::abs(a.row - b.row);
     int colDiff = std::abs(a.col - b.col);
     return (rowDiff == 1 && colDiff == 0) || (rowDiff == 0 && colDiff == 1);
 }
 
-bool BoardLogic::wouldCreateMatch(const BoardState& state, int row, int col, GemType type) const {
+template <int Rows, int Cols, int Colors>
+bool BasicBoardLogic<Rows, Cols, Colors>::wouldCreateMatch(const State& state, int row, int col, GemType type) const {
     if (type == GemType::EMPTY) return false;
 
     // Check horizontal
@@ -164,7 +269,7 @@ bool BoardLogic::wouldCreateMatch(const BoardState& state, int row, int col, Gem
     for (int c = col - 1; c >= 0 && state.at(row, c) == type; --c) {
         horizontalCount++;
     }
-    for (int c = col + 1; c < BoardState::COLS && state.at(row, c) == type; ++c) {
+    for (int c = col + 1; c < State::COLS && state.at(row, c) == type; ++c) {
         horizontalCount++;
     }
     if (horizontalCount >= 3) return true;
@@ -174,7 +279,7 @@ bool BoardLogic::wouldCreateMatch(const BoardState& state, int row, int col, Gem
     for (int r = row - 1; r >= 0 && state.at(r, col) == type; --r) {
         verticalCount++;
     }
-    for (int r = row + 1; r < BoardState::ROWS && state.at(r, col) == type; ++r) {
+    for (int r = row + 1; r < State::ROWS && state.at(r, col) == type; ++r) {
         verticalCount++;
     }
     if (verticalCount >= 3) return true;
@@ -182,86 +287,122 @@ bool BoardLogic::wouldCreateMatch(const BoardState& state, int row, int col, Gem
     return false;
 }
 
-void BoardLogic::executeSwap(BoardState& state, const Move& move) const {
-    std::swap(state.at(move.from.row, move.from.col),
-              state.at(move.to.row, move.to.col));
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::Mask
+BasicBoardLogic<Rows, Cols, Colors>::executeSwap(State& state, const Move& move) const {
+    state.swap(move.from.row, move.from.col, move.to.row, move.to.col);
+    return State::bit(move.from.row, move.from.col) | State::bit(move.to.row, move.to.col);
 }
 
-bool BoardLogic::hasValidMoves(const BoardState& state) const {
-    for (int row = 0; row < BoardState::ROWS; ++row) {
-        for (int col = 0; col < BoardState::COLS; ++col) {
-            if (state.at(row, col) == GemType::EMPTY) continue;
-
-            GemType type1 = state.at(row, col);
-
-            // Check right swap
-            if (col + 1 < BoardState::COLS && state.at(row, col + 1) != GemType::EMPTY) {
-                GemType type2 = state.at(row, col + 1);
-
-                // Temporarily swap and check
-                BoardState temp = state;
-                temp.at(row, col) = type2;
-                temp.at(row, col + 1) = type1;
-
-                if (wouldCreateMatch(temp, row, col, type2) ||
-                    wouldCreateMatch(temp, row, col + 1, type1)) {
-                    return true;
-                }
-            }
+template <int Rows, int Cols, int Colors>
+bool BasicBoardLogic<Rows, Cols, Colors>::hasValidMoves(const State& state) const {
+    if (hasColorSwaps(state)) {
+        return true;
+    }
 
-            // Check down swap
-            if (row + 1 < BoardState::ROWS && state.at(row + 1, col) != GemType::EMPTY) {
-                GemType type2 = state.at(row + 1, col);
+    // Swapping two gems of the same color changes nothing, so it only
+    // counts when one of them is already part of a match
+    SwapMasks masks = sameColorSwapMasks(state);
+    return static_cast<bool>(masks.horizontal | masks.vertical);
+}
 
-                // Temporarily swap and check
-                BoardState temp = state;
-                temp.at(row, col) = type2;
-                temp.at(row + 1, col) = type1;
+template <int Rows, int Cols, int Colors>
+bool BasicBoardLogic<Rows, Cols, Colors>::hasColorSwaps(const State& state) const {
+    if constexpr (BoardKernels::LANE_MASKS<State>) {
+        if (const BoardKernels::LaneKernels* kernels = activeLaneKernels<State>()) {
+            return kernels->hasSwaps(state.colorMaskData(), state.occupied());
+        }
+    }
 
-                if (wouldCreateMatch(temp, row, col, type2) ||
-                    wouldCreateMatch(temp, row + 1, col, type1)) {
-                    return true;
-                }
-            }
+    for (int i = 0; i < Colors; ++i) {
+        SwapMasks masks = colorSwapMasks<State, SwapMasks>(state.mask(static_cast<GemType>(i)), state.occupied());
+        if (masks.horizontal | masks.vertical) {
+            return true;
         }
     }
     return false;
 }
 
-BoardLogic::SequenceResult BoardLogic::executeSequence(BoardState& state, const Move& move) const {
-    SequenceResult result;
+template <int Rows, int Cols, int Colors>
+int BasicBoardLogic<Rows, Cols, Colors>::countValidMoves(const State& state) const {
+    SwapMasks masks = validSwapMasks(state);
+    return BitUtils::popcount(masks.horizontal) + BitUtils::popcount(masks.vertical);
+}
 
-    if (!isValidSwap(state, move)) {
-        return result;
+template <int Rows, int Cols, int Colors>
+void BasicBoardLogic<Rows, Cols, Colors>::enumerateValidMoves(const State& state, std::vector<Move>& moves) const {
+    moves.clear();
+    SwapMasks masks = validSwapMasks(state);
+
+    // Same order as a row-major scan trying the right swap, then the down swap
+    for (Mask cells = masks.horizontal | masks.vertical; cells; cells = BitUtils::clearLowest(cells)) {
+        int index = BitUtils::countTrailingZeros(cells);
+        int row = index / State::COLS;
+        int col = index % State::COLS;
+        if (masks.horizontal & State::bit(row, col)) {
+            moves.push_back({{row, col}, {row, col + 1}});
+        }
+        if (masks.vertical & State::bit(row, col)) {
+            moves.push_back({{row, col}, {row + 1, col}});
+        }
     }
+}
 
-    // Execute swap
-    executeSwap(state, move);
-
-    // Check if swap creates a match
-    auto matchResult = checkMatches(state);
-    if (matchResult.matchedPositions.empty()) {
-        // Invalid swap - reverse it
-        executeSwap(state, move);
-        return result;
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::SwapMasks
+BasicBoardLogic<Rows, Cols, Colors>::validSwapMasks(const State& state) const {
+    if constexpr (BoardKernels::LANE_MASKS<State>) {
+        if (const BoardKernels::LaneKernels* kernels = activeLaneKernels<State>()) {
+            auto masks = kernels->validSwapMasks(state.colorMaskData(), state.occupied());
+            return {masks.horizontal, masks.vertical};
+        }
     }
 
-    result.swapValid = true;
-
-    // Process cascades
-    while (!matchResult.matchedPositions.empty()) {
-        result.matches.push_back(matchResult);
-        result.totalScore += matchResult.score;
-
-        removeMatches(state, matchResult.matchedPositions);
-        auto gravityResult = applyGravity(state);
-        result.gravities.push_back(gravityResult);
-
-        fillEmpty(state, gravityResult.emptyPositions);
+    SwapMasks masks = sameColorSwapMasks(state);
+    for (int i = 0; i < Colors; ++i) {
+        SwapMasks color = colorSwapMasks<State, SwapMasks>(state.mask(static_cast<GemType>(i)), state.occupied());
+        masks.horizontal |= color.horizontal;
+        masks.vertical |= color.vertical;
+    }
+    return masks;
+}
 
-        matchResult = checkMatches(state);
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::SwapMasks
+BasicBoardLogic<Rows, Cols, Colors>::sameColorSwapMasks(const State& state) const {
+    using M = BoardMasks<State>;
+    SwapMasks pairs;
+    for (int i = 0; i < Colors; ++i) {
+        const Mask gems = state.mask(static_cast<GemType>(i));
+        pairs.horizontal |= gems & (gems >> 1) & M::NOT_LAST_COLUMN;
+        pairs.vertical |= gems & (gems >> M::ROW_STRIDE);
+    }
+    if (!(pairs.horizontal | pairs.vertical)) {
+        return pairs;
     }
 
-    state.score += result.totalScore;
+    const Mask matched = findMatchMask(state);
+    pairs.horizontal &= matched | (matched >> 1);
+    pairs.vertical &= matched | (matched >> M::ROW_STRIDE);
+    return pairs;
+}
+
+template <int Rows, int Cols, int Colors>
+typename BasicBoardLogic<Rows, Cols, Colors>::SequenceResult
+BasicBoardLogic<Rows, Cols, Colors>::executeSequence(State& state, const Move& move) const {
+    SequenceResult result;
+    executeSequence(state, move, result);
     return result;
 }
+
+template <int Rows, int Cols, int Colors>
+void BasicBoardLogic<Rows, Cols, Colors>::executeSequence(State& state, const Move& move,
+                                                          SequenceResult& result) const {
+    runSequence(state, move, [this](State& board, PositionSpan positions) {
+        return fillEmpty(board, positions);
+    }, result);
+}
+
+#define MATCH3_INSTANTIATE_BOARD_LOGIC(R, C, K) template class BasicBoardLogic<R, C, K>;
+MATCH3_BOARD_SHAPES(MATCH3_INSTANTIATE_BOARD_LOGIC)
+#undef MATCH3_INSTANTIATE_BOARD_LOGIC
@@ -1,29 +1,80 @@
 #pragma once
 
 #include "BoardTypes.h"
+#include "Random.h"
 #include <vector>
 #include <optional>
 
-class BoardLogic {
+// Board shapes with compiled rules, as X(rows, cols, colors). The rules are
+// explicitly instantiated for each shape in BoardLogic.cpp, so loop bounds
+// are compile-time constants in every variant.
+#define MATCH3_BOARD_SHAPES(X) \
+    X(8, 8, 4) X(8, 8, 5) X(8, 8, 6) \
+    X(7, 9, 4) X(7, 9, 5) X(7, 9, 6) \
+    X(9, 9, 4) X(9, 9, 5) X(9, 9, 6) \
+    X(10, 12, 4) X(10, 12, 5) X(10, 12, 6)
+
+template <int Rows, int Cols, int Colors = static_cast<int>(GemType::COUNT)>
+class BasicBoardLogic {
 public:
-    explicit BoardLogic(GemFactory factory = nullptr);
+    using State = BasicBoardState<Rows, Cols, Colors>;
+    using Mask = typename State::Mask;
+    using MatchResult = BasicMatchResult<State::CELLS>;
+    using GravityResult = BasicGravityResult<State::CELLS>;
+
+    static_assert(2 * Cols < 64, "Row shifts must fit in one bitboard word");
+
+    // Without a factory, gems come from the logic's own generator, seeded
+    // from std::random_device unless a seed is given. The generator lives in
+    // this object, so use one BoardLogic per thread.
+    explicit BasicBoardLogic(GemFactory factory = nullptr);
+    explicit BasicBoardLogic(uint64_t seed);
+
+    // Restart the gem sequence; the same seed replays the same boards and refills
+    void seed(uint64_t value) { rng.seed(value); }
+
+    // Fill `out` with `count` uniformly random gem types. Refills use this
+    // bulk path, which draws two gems per generator step.
+    void generateGems(GemType* out, int count) const;
 
     // Initialize board, avoiding initial matches
-    void initializeBoard(BoardState& state) const;
+    void initializeBoard(State& state) const;
+
+    // Core game rules - pure functions operating on the board state
+    MatchResult checkMatches(const State& state) const;
+    Mask findMatchMask(const State& state) const;
+    GravityResult applyGravity(State& state) const;
+    void removeMatches(State& state, PositionSpan positions) const;
+    Mask fillEmpty(State& state, PositionSpan positions) const;
 
-    // Core game rules - pure functions operating on BoardState
-    MatchResult checkMatches(const BoardState& state) const;
-    GravityResult applyGravity(BoardState& state) const;
-    void removeMatches(BoardState& state, const std::vector<Position>& positions) const;
-    void fillEmpty(BoardState& state, const std::vector<Position>& positions) const;
+    // Incremental variants: only report runs that contain a dirty cell.
+    // On a board that had no matches before the dirty cells changed, this
+    // is the same as a full scan.
+    MatchResult checkMatches(const State& state, Mask dirty) const;
+    Mask findMatchMask(const State& state, Mask dirty) const;
 
     // Swap validation and execution
-    bool isValidSwap(const BoardState& state, const Move& move) const;
-    bool wouldCreateMatch(const BoardState& state, int row, int col, GemType type) const;
-    void executeSwap(BoardState& state, const Move& move) const;
+    bool isValidSwap(const State& state, const Move& move) const;
+    bool wouldCreateMatch(const State& state, int row, int col, GemType type) const;
+    Mask executeSwap(State& state, const Move& move) const;
 
-    // Check for valid moves remaining
-    bool hasValidMoves(const BoardState& state) const;
+    // Check for valid moves remaining. Moves are found by matching move
+    // templates against the color bitboards, without copying the board.
+    // On boards of up to 64 cells these scans and the full findMatchMask
+    // run several colors per vector register, at simdLevel() (SimdLevel.h).
+    bool hasValidMoves(const State& state) const;
+    int countValidMoves(const State& state) const;
+    // Fills `moves` (cleared first) with every swap that creates a match,
+    // in row-major order of the top/left cell
+    void enumerateValidMoves(const State& state, std::vector<Move>& moves) const;
+
+    // Valid swaps, each marked at its top/left cell: bit a of `horizontal`
+    // means swapping a with a + 1, bit a of `vertical` swapping a with a + COLS
+    struct SwapMasks {
+        Mask horizontal{};
+        Mask vertical{};
+    };
+    SwapMasks validSwapMasks(const State& state) const;
 
     // Execute a complete sequence (swap -> matches -> gravity -> cascades)
     struct SequenceResult {
@@ -32,15 +83,134 @@ public:
         std::vector<GravityResult> gravities;
         int totalScore = 0;
     };
-    SequenceResult executeSequence(BoardState& state, const Move& move) const;
+    SequenceResult executeSequence(State& state, const Move& move) const;
+    // Same, writing into `result` (reset first). Reusing one result keeps
+    // the capacity of its lists, so repeated sequences make no allocations.
+    void executeSequence(State& state, const Move& move, SequenceResult& result) const;
+
+    // Variants taking new gems from `generate`, any callable
+    // GemType(int row, int col) such as those in GemGenerators.h, instead
+    // of the logic's own generator or factory. The call is resolved at
+    // compile time, so it inlines into the refill loop.
+    template <typename Generator>
+    void initializeBoard(State& state, Generator&& generate) const;
+    template <typename Generator>
+    Mask fillEmpty(State& state, PositionSpan positions, Generator&& generate) const;
+    template <typename Generator>
+    SequenceResult executeSequence(State& state, const Move& move, Generator&& generate) const;
+    template <typename Generator>
+    void executeSequence(State& state, const Move& move, Generator&& generate, SequenceResult& result) const;
 
 private:
     GemFactory gemFactory;
+    mutable Xoshiro256 rng;
 
-    void findHorizontalMatches(const BoardState& state, int row, int col,
-                               std::vector<Position>& matches) const;
-    void findVerticalMatches(const BoardState& state, int row, int col,
-                             std::vector<Position>& matches) const;
     bool areAdjacent(const Position& a, const Position& b) const;
-    GemType getRandomGemType() const;
+    MatchResult toMatchResult(Mask matched) const;
+    SwapMasks sameColorSwapMasks(const State& state) const;
+    // Whether a swap moves some gem into a run of its color
+    bool hasColorSwaps(const State& state) const;
+
+    // Shared by the executeSequence overloads; `fill` refills the cells
+    // emptied by gravity and returns their mask
+    template <typename Fill>
+    void runSequence(State& state, const Move& move, Fill&& fill, SequenceResult& result) const;
 };
+
+template <int Rows, int Cols, int Colors>
+template <typename Generator>
+void BasicBoardLogic<Rows, Cols, Colors>::initializeBoard(State& state, Generator&& generate) const {
+    for (int row = 0; row < State::ROWS; ++row) {
+        for (int col = 0; col < State::COLS; ++col) {
+            GemType type;
+            do {
+                type = generate(row, col);
+            } while (wouldCreateMatch(state, row, col, type));
+            state.at(row, col) = type;
+        }
+    }
+}
+
+template <int Rows, int Cols, int Colors>
+template <typename Generator>
+typename BasicBoardLogic<Rows, Cols, Colors>::Mask
+BasicBoardLogic<Rows, Cols, Colors>::fillEmpty(State& state, PositionSpan positions,
+                                               Generator&& generate) const {
+    Mask filled{};
+    for (const auto& pos : positions) {
+        if (state.isValid(pos.row, pos.col) && state.at(pos.row, pos.col) == GemType::EMPTY) {
+            state.at(pos.row, pos.col) = generate(pos.row, pos.col);
+            filled |= State::bit(pos.row, pos.col);
+        }
+    }
+    return filled;
+}
+
+template <int Rows, int Cols, int Colors>
+template <typename Generator>
+typename BasicBoardLogic<Rows, Cols, Colors>::SequenceResult
+BasicBoardLogic<Rows, Cols, Colors>::executeSequence(State& state, const Move& move, Generator&& generate) const {
+    SequenceResult result;
+    executeSequence(state, move, generate, result);
+    return result;
+}
+
+template <int Rows, int Cols, int Colors>
+template <typename Generator>
+void BasicBoardLogic<Rows, Cols, Colors>::executeSequence(State& state, const Move& move, Generator&& generate,
+                                                          SequenceResult& result) const {
+    runSequence(state, move, [this, &generate](State& board, PositionSpan positions) {
+        return fillEmpty(board, positions, generate);
+    }, result);
+}
+
+template <int Rows, int Cols, int Colors>
+template <typename Fill>
+void BasicBoardLogic<Rows, Cols, Colors>::runSequence(State& state, const Move& move, Fill&& fill,
+                                                      SequenceResult& result) const {
+    result.swapValid = false;
+    result.matches.clear();
+    result.gravities.clear();
+    result.totalScore = 0;
+
+    if (!isValidSwap(state, move)) {
+        return;
+    }
+
+    // Execute swap
+    Mask dirty = executeSwap(state, move);
+
+    // Check if swap creates a match
+    auto matchResult = checkMatches(state, dirty);
+    if (matchResult.matchedPositions.empty()) {
+        // Invalid swap - reverse it
+        executeSwap(state, move);
+        return;
+    }
+
+    result.swapValid = true;
+
+    // Process cascades
+    while (!matchResult.matchedPositions.empty()) {
+        result.matches.push_back(matchResult);
+        result.totalScore += matchResult.score;
+
+        removeMatches(state, matchResult.matchedPositions);
+        result.gravities.push_back(applyGravity(state));
+        const GravityResult& gravityResult = result.gravities.back();
+
+        Mask filled = fill(state, gravityResult.emptyPositions);
+
+        // Only cells that received a gem can start a cascade
+        matchResult = checkMatches(state, gravityResult.dirty | filled);
+    }
+
+    state.score += result.totalScore;
+}
+
+#define MATCH3_EXTERN_BOARD_LOGIC(R, C, K) extern template class BasicBoardLogic<R, C, K>;
+MATCH3_BOARD_SHAPES(MATCH3_EXTERN_BOARD_LOGIC)
+#undef MATCH3_EXTERN_BOARD_LOGIC
+
+// The standard 8x8 rules used by the game
+using BoardLogic = BasicBoardLogic<BoardState::ROWS, BoardState::COLS>;
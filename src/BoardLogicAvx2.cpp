@@ -0,0 +1,39 @@
+// AVX2 kernels for BoardLogic, four colors per register. CMake compiles
+// this file, and only this file, with AVX2 enabled on x86-64; BoardLogic
+// calls into it only after SimdLevel has checked the CPU.
+//
+// Everything compiled here must be specific to AVX2. Calling an inline
+// function shared with other files (board accessors, standard library
+// helpers) would emit an AVX2 copy of it that the linker may pick for the
+// whole program, so the kernels work on raw bitboard arrays.
+
+#include "BoardKernels.h"
+#include "BoardLogic.h"
+
+namespace BoardKernels {
+
+template <typename State>
+const LaneKernels* avx2Kernels() {
+#if defined(__AVX2__)
+    if constexpr (LANE_MASKS<State>) {
+        static constexpr LaneKernels kernels = makeLaneKernels<State, Avx2Lanes>();
+        return &kernels;
+    }
+#endif
+    return nullptr;
+}
+
+bool avx2Built() {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+#define MATCH3_INSTANTIATE_AVX2_KERNELS(R, C, K) \
+    template const LaneKernels* avx2Kernels<BasicBoardState<R, C, K>>();
+MATCH3_BOARD_SHAPES(MATCH3_INSTANTIATE_AVX2_KERNELS)
+#undef MATCH3_INSTANTIATE_AVX2_KERNELS
+
+} // namespace BoardKernels
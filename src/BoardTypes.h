@@ -1,10 +1,16 @@
 #pragma once
 
+#include "Bitboard.h"
+#include "Random.h"
+#include "StaticVector.h"
+#include <array>
 #include <vector>
 #include <utility>
 #include <functional>
+#include <cstdint>
 
-enum class GemType {
+// One byte per cell, so an 8x8 board's gems fit in a 64-byte cache line
+enum class GemType : uint8_t {
     RED,
     GREEN,
     BLUE,
@@ -15,9 +21,15 @@ enum class GemType {
     EMPTY
 };
 
+// Two bytes: boards have fewer than 128 rows and columns. Constructed from
+// ints, so {row, col} works with any integer expression.
 struct Position {
-    int row;
-    int col;
+    int8_t row;
+    int8_t col;
+
+    Position() = default;
+    constexpr Position(int row, int col)
+        : row(static_cast<int8_t>(row)), col(static_cast<int8_t>(col)) {}
 
     bool operator==(const Position& other) const {
         return row == other.row && col == other.col;
@@ -32,6 +44,10 @@ struct Position {
 struct Move {
     Position from;
     Position to;
+
+    bool operator==(const Move& other) const {
+        return from == other.from && to == other.to;
+    }
 };
 
 struct GravityMove {
@@ -39,40 +55,202 @@ struct GravityMove {
     Position to;
 };
 
-struct MatchResult {
-    std::vector<Position> matchedPositions;
+static_assert(sizeof(GemType) == 1, "GemType must stay one byte");
+static_assert(sizeof(Position) == 2 && sizeof(Move) == 4 && sizeof(GravityMove) == 4,
+              "Positions and moves must stay packed");
+
+// Read-only view of a contiguous list of positions, such as a std::vector
+// or a StaticVector
+class PositionSpan {
+public:
+    template <typename Container>
+    PositionSpan(const Container& positions) : first(positions.data()), count(positions.size()) {}
+
+    const Position* begin() const { return first; }
+    const Position* end() const { return first + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Position& operator[](size_t index) const { return first[index]; }
+
+private:
+    const Position* first;
+    size_t count;
+};
+
+// Results are sized from the board, so producing them never allocates:
+// a scan matches each cell at most once, and gravity moves or empties each
+// cell at most once.
+template <int Cells>
+struct BasicMatchResult {
+    StaticVector<Position, Cells> matchedPositions;
     int score = 0;
 };
 
-struct GravityResult {
-    std::vector<GravityMove> moves;
-    std::vector<Position> emptyPositions;
+// Zobrist keys: one random 64-bit value per (cell, gem type). A board's hash
+// is the XOR of the keys of its gems, so changing a cell updates it in O(1).
+// Empty cells contribute nothing.
+template <int Cells>
+struct ZobristKeys {
+    static constexpr int TYPES = static_cast<int>(GemType::COUNT);
+
+    static constexpr std::array<uint64_t, Cells * TYPES> make() {
+        std::array<uint64_t, Cells * TYPES> keys{};
+        uint64_t seed = 0x5A0B1A57ull;
+        for (auto& key : keys) {
+            key = splitMix64(seed);
+        }
+        return keys;
+    }
+
+    static constexpr std::array<uint64_t, Cells * TYPES> table = make();
+
+    static uint64_t key(int cell, GemType type) {
+        return table[static_cast<size_t>(cell * TYPES + static_cast<int>(type))];
+    }
+};
+
+template <int Cells>
+struct BasicGravityResult {
+    StaticVector<GravityMove, Cells> moves;
+    StaticVector<Position, Cells> emptyPositions;
+    BitboardFor<Cells> dirty{};  // Cells that received a falling gem
 };
 
-class BoardState {
+// Board of Rows x Cols cells using the first Colors gem types. Each color
+// (and the set of occupied cells) is mirrored in a bitboard with bit index
+// row * Cols + col, so rules can work on whole rows and columns at once.
+template <int Rows, int Cols, int Colors = static_cast<int>(GemType::COUNT)>
+class BasicBoardState {
 public:
-    static const int ROWS = 8;
-    static const int COLS = 8;
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+    static constexpr int CELLS = ROWS * COLS;
+    static constexpr int COLORS = Colors;
+    static_assert(COLORS >= 3 && COLORS <= static_cast<int>(GemType::COUNT),
+                  "Colors must be between 3 and GemType::COUNT");
+
+    using Mask = BitboardFor<CELLS>;
+
+    // Writable reference to a cell. Assignments go through set() so the
+    // per-color bitboards stay in sync with the gem array.
+    class CellRef {
+    public:
+        CellRef(BasicBoardState& board, int row, int col) : board(board), row(row), col(col) {}
+
+        CellRef& operator=(GemType type) {
+            board.set(row, col, type);
+            return *this;
+        }
+        CellRef& operator=(const CellRef& other) {
+            return *this = static_cast<GemType>(other);
+        }
 
-    BoardState() {
+        operator GemType() const { return board.gems[row][col]; }
+
+    private:
+        BasicBoardState& board;
+        int row;
+        int col;
+    };
+
+    BasicBoardState() {
         for (int row = 0; row < ROWS; ++row) {
             for (int col = 0; col < COLS; ++col) {
                 gems[row][col] = GemType::EMPTY;
             }
         }
+        for (auto& mask : colorMasks) {
+            mask = Mask{};
+        }
     }
 
-    GemType& at(int row, int col) { return gems[row][col]; }
+    CellRef at(int row, int col) { return CellRef(*this, row, col); }
     GemType at(int row, int col) const { return gems[row][col]; }
 
+    void set(int row, int col, GemType type) {
+        const Mask b = bit(row, col);
+        const int index = row * COLS + col;
+        GemType& cell = gems[row][col];
+        if (isGem(cell)) {
+            colorMasks[static_cast<int>(cell)] &= ~b;
+            zobrist ^= Keys::key(index, cell);
+        }
+        if (isGem(type)) {
+            colorMasks[static_cast<int>(type)] |= b;
+            zobrist ^= Keys::key(index, type);
+            occupancy |= b;
+        } else {
+            occupancy &= ~b;
+        }
+        cell = type;
+    }
+
+    void swap(int row1, int col1, int row2, int col2) {
+        GemType first = gems[row1][col1];
+        set(row1, col1, gems[row2][col2]);
+        set(row2, col2, first);
+    }
+
     bool isValid(int row, int col) const {
         return row >= 0 && row < ROWS && col >= 0 && col < COLS;
     }
 
+    // Cells holding a gem of the given color
+    Mask mask(GemType type) const {
+        return isGem(type) ? colorMasks[static_cast<int>(type)] : Mask{};
+    }
+    // Cells holding any gem
+    Mask occupied() const { return occupancy; }
+    // Every color's mask, COLORS of them in GemType order
+    const Mask* colorMaskData() const { return colorMasks; }
+
+    // Zobrist hash of the gem layout, kept up to date by every write. Equal
+    // layouts hash equally however they were reached; score is not included.
+    uint64_t hash() const { return zobrist; }
+
+    static constexpr Mask bit(int row, int col) {
+        if constexpr (CELLS <= 64) {
+            return Mask(1) << (row * COLS + col);
+        } else {
+            return Mask::bit(row * COLS + col);
+        }
+    }
+    static constexpr Mask rowMask(int row) {
+        Mask mask{};
+        for (int col = 0; col < COLS; ++col) {
+            mask |= bit(row, col);
+        }
+        return mask;
+    }
+    static constexpr Mask columnMask(int col) {
+        Mask mask{};
+        for (int row = 0; row < ROWS; ++row) {
+            mask |= bit(row, col);
+        }
+        return mask;
+    }
+    // Gem types past COLORS are not used on this board
+    static constexpr bool isGem(GemType type) {
+        return static_cast<int>(type) < COLORS;
+    }
+
     int score = 0;
 
 private:
-    GemType gems[ROWS][COLS];
+    using Keys = ZobristKeys<CELLS>;
+
+    alignas(64) GemType gems[ROWS][COLS];
+    Mask colorMasks[COLORS];
+    Mask occupancy{};
+    uint64_t zobrist = 0;
 };
 
+// The standard 8x8 board used by the game
+using BoardState = BasicBoardState<8, 8>;
+using Bitboard = BoardState::Mask;
+using MatchResult = BasicMatchResult<BoardState::CELLS>;
+using GravityResult = BasicGravityResult<BoardState::CELLS>;
+
+// Type-erased gem source, accepted by BoardLogic's constructor. Hot paths
+// should pass a generator from GemGenerators.h to the templated overloads.
 using GemFactory = std::function<GemType(int row, int col)>;
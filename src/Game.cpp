@@ -1,13 +1,51 @@
 #include "Game.h"
 #include "MathUtils.h"
+#include "Profiler.h"
 #include <SDL3_ttf/SDL_ttf.h>
+#include <random>
+
+namespace {
+
+const float SIMULATION_STEP = 1.0f / Game::SIMULATION_RATE;
+const Uint64 SIMULATION_STEP_NS = 1000000000ull / Game::SIMULATION_RATE;
+
+// Longer stalls (debugger, app in background) are dropped, not simulated
+const float MAX_FRAME_TIME = 0.25f;
+const Uint64 MAX_LAG_NS = 250000000ull;
+
+#if MATCH3_PROFILING
+// Written to the app's preferences directory, which is writable on mobile
+// too (pull it with adb on Android)
+void writeTrace() {
+    std::string path = "match3-trace.json";
+    if (char* prefPath = SDL_GetPrefPath("Match3", "Match3Game")) {
+        path = std::string(prefPath) + path;
+        SDL_free(prefPath);
+    }
+    if (Profiler::instance().writeChromeTrace(path)) {
+        SDL_Log("Wrote profiler trace to %s", path.c_str());
+    } else {
+        SDL_Log("Warning: Could not write profiler trace to %s", path.c_str());
+    }
+}
+#endif
+
+} // namespace
 
 Game::Game()
     : window(nullptr)
     , renderer(nullptr)
     , running(false)
+    , autoPlay(false)
     , state(GameState::PLAYING)
     , lastTime(0)
+    , accumulator(0.0f)
+    , threadedSimulation(false)
+    , lastStepTime(0)
+    , stepCount(0)
+    , recording(false)
+    , replaying(false)
+    , nextReplaySwap(0)
 {
 }
 
@@ -15,7 +53,39 @@ Game::~Game() {
     cleanup();
 }
 
-bool Game::init() {
+bool Game::init(const GameOptions& options) {
+    threadedSimulation = options.threadedSimulation;
+
+    uint64_t seed;
+    if (!options.replayPath.empty()) {
+        std::optional<Replay> loaded = loadReplay(options.replayPath);
+        if (!loaded) {
+            SDL_Log("Could not read replay %s", options.replayPath.c_str());
+            return false;
+        }
+        if (loaded->stepRate != SIMULATION_RATE) {
+            SDL_Log("Warning: Replay was recorded at %d steps per second; playing at %d",
+                    loaded->stepRate, SIMULATION_RATE);
+        }
+        replay = std::move(*loaded);
+        replaying = true;
+        seed = replay.seed;
+        SDL_Log("Playing replay %s: %zu swaps", options.replayPath.c_str(), replay.swaps.size());
+    } else if (options.seed) {
+        seed = *options.seed;
+    } else {
+        std::random_device device;
+        seed = (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+    SDL_Log("Seed: %llu", static_cast<unsigned long long>(seed));
+
+    if (!options.recordPath.empty() && !replaying) {
+        recording = true;
+        recordPath = options.recordPath;
+        replay.seed = seed;
+        replay.stepRate = SIMULATION_RATE;
+    }
+
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         SDL_Log("SDL initialization failed: %s", SDL_GetError());
         return false;
@@ -56,35 +126,104 @@ bool Game::init() {
     SDL_GetRenderOutputSize(renderer, &windowWidth, &windowHeight);
 
     // Initialize game objects
-    grid = std::make_unique<Grid>();
+    grid = std::make_unique<Grid>(seed);
     gameRenderer = std::make_unique<Renderer>(renderer, windowWidth, windowHeight);
     inputHandler = std::make_unique<InputHandler>(
         gameRenderer->getGemSize(),
         gameRenderer->getGridOffsetX(),
         gameRenderer->getGridOffsetY()
     );
+    moveSearcher = std::make_unique<MoveSearcher>();  // Fits in one frame by default
 
-    lastTime = SDL_GetTicks();
+    lastTime = SDL_GetTicksNS();
+    lastStepTime = lastTime;
     running = true;
 
     return true;
 }
 
 void Game::run() {
+    if (threadedSimulation) {
+        simulationThread = std::thread(&Game::runSimulation, this);
+    }
+
     while (running) {
-        Uint64 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
+        PROFILE_FRAME();
+        Uint64 currentTime = SDL_GetTicksNS();
+        float frameTime = (currentTime - lastTime) / 1e9f;
         lastTime = currentTime;
 
-        deltaTime = MathUtils::clampDeltaTime(deltaTime);
+        if (threadedSimulation) {
+            {
+                std::lock_guard<std::mutex> lock(simulationMutex);
+                handleEvents();
+                float blend = (currentTime - lastStepTime) / static_cast<float>(SIMULATION_STEP_NS);
+                render(MathUtils::clamp(blend, 0.0f, 1.0f));
+            }
+            gameRenderer->present();
+            continue;
+        }
+
+        accumulator += MathUtils::clampDeltaTime(frameTime, MAX_FRAME_TIME);
 
         handleEvents();
-        update(deltaTime);
-        render();
+        while (accumulator >= SIMULATION_STEP) {
+            update(SIMULATION_STEP);
+            accumulator -= SIMULATION_STEP;
+        }
+        // Draw the leftover fraction of a step by interpolating
+        render(accumulator / SIMULATION_STEP);
+        gameRenderer->present();
+    }
+
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
+}
+
+void Game::runSimulation() {
+    Uint64 nextStep = SDL_GetTicksNS();
+    while (running) {
+        Uint64 now = SDL_GetTicksNS();
+        if (now < nextStep) {
+            SDL_DelayNS(nextStep - now);
+            continue;
+        }
+        if (now - nextStep > MAX_LAG_NS) {
+            nextStep = now;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(simulationMutex);
+            update(SIMULATION_STEP);
+            lastStepTime = nextStep;
+        }
+        nextStep += SIMULATION_STEP_NS;
     }
 }
 
 void Game::cleanup() {
+    running = false;
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
+
+#if MATCH3_PROFILING
+    if (gameRenderer) {
+        writeTrace();
+    }
+#endif
+
+    if (recording && grid) {
+        replay.finalScore = grid->getScore();
+        if (saveReplay(replay, recordPath)) {
+            SDL_Log("Saved replay to %s: %zu swaps", recordPath.c_str(), replay.swaps.size());
+        } else {
+            SDL_Log("Warning: Could not save replay to %s", recordPath.c_str());
+        }
+    }
+
+    moveSearcher.reset();
     inputHandler.reset();
     gameRenderer.reset();
     grid.reset();
@@ -104,12 +243,17 @@ void Game::cleanup() {
 }
 
 void Game::handleEvents() {
+    PROFILE_SCOPE("Game::handleEvents");
+
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_EVENT_QUIT) {
             running = false;
         }
-        else if (event.type == SDL_EVENT_WINDOW_RESIZED) {
+        else if (event.type == SDL_EVENT_WINDOW_RESIZED ||
+                 event.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+            // Pixel size also changes when the window moves to a display
+            // with a different scale
             int width, height;
             SDL_GetRenderOutputSize(renderer, &width, &height);
             gameRenderer->setWindowSize(width, height);
@@ -122,6 +266,21 @@ void Game::handleEvents() {
         else if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_ESCAPE) {
             running = false;
         }
+        else if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_H) {
+            showHint();
+        }
+        else if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_A) {
+            autoPlay = !autoPlay;
+            SDL_Log("Auto-play %s", autoPlay ? "on" : "off");
+        }
+#if MATCH3_PROFILING
+        else if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F) {
+            gameRenderer->toggleFrameGraph();
+        }
+        else if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_T) {
+            writeTrace();
+        }
+#endif
         else {
             inputHandler->handleEvent(event, renderer);
         }
@@ -136,27 +295,78 @@ void Game::update(float deltaTime) {
     }
 
     updateGameLogic(deltaTime);
+    ++stepCount;
 }
 
-void Game::render() {
-    gameRenderer->render(*grid);
+void Game::render(float blend) {
+    gameRenderer->render(*grid, blend);
 }
 
 void Game::processInput() {
+    if (replaying) {
+        playReplaySwaps();
+        return;
+    }
+
+    if (autoPlay) {
+        SearchResult result = moveSearcher->search(grid->getBoardState());
+        if (result.found) {
+            applySwap(result.bestMove);
+        }
+        return;
+    }
+
     if (inputHandler->hasPendingSwap()) {
         int row1, col1, row2, col2;
         inputHandler->getSwap(row1, col1, row2, col2);
-
-        if (grid->swapGems(row1, col1, row2, col2)) {
-            state = GameState::CHECKING_MATCHES;
-        }
+        applySwap(Move{Position(row1, col1), Position(row2, col2)});
 
         inputHandler->clearSwap();
         inputHandler->clearSelection();
     }
 }
 
+bool Game::applySwap(const Move& move) {
+    if (!grid->swapGems(move.from.row, move.from.col, move.to.row, move.to.col)) {
+        return false;
+    }
+    if (recording) {
+        replay.swaps.push_back(ReplaySwap{stepCount, move});
+    }
+    state = GameState::CHECKING_MATCHES;
+    return true;
+}
+
+void Game::playReplaySwaps() {
+    // The game is in the same state as when recording, so each swap is
+    // due exactly at its step
+    if (nextReplaySwap < replay.swaps.size()) {
+        const ReplaySwap& swap = replay.swaps[nextReplaySwap];
+        if (swap.step <= stepCount) {
+            ++nextReplaySwap;
+            applySwap(swap.move);
+        }
+    } else if (nextReplaySwap == replay.swaps.size()) {
+        SDL_Log("Replay finished. Score: %d (recorded %d)", grid->getScore(), replay.finalScore);
+        ++nextReplaySwap;  // Report once
+    }
+}
+
+void Game::showHint() {
+    SearchResult result = moveSearcher->search(grid->getBoardState());
+    if (!result.found) {
+        SDL_Log("Hint: no valid moves");
+        return;
+    }
+    SDL_Log("Hint: swap (%d,%d) with (%d,%d), about %d points over %d moves (%.1f ms)",
+            result.bestMove.from.row, result.bestMove.from.col,
+            result.bestMove.to.row, result.bestMove.to.col,
+            result.expectedScore, result.depth, result.elapsedMs);
+}
+
 void Game::updateGameLogic(float deltaTime) {
+    PROFILE_SCOPE("Game::updateGameLogic");
+
     if (grid->isAnimating()) {
         return;
     }
@@ -3,8 +3,15 @@
 #include "Grid.h"
 #include "Renderer.h"
 #include "InputHandler.h"
+#include "MoveSearcher.h"
+#include "Replay.h"
 #include <SDL3/SDL.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
 
 enum class GameState {
     PLAYING,
@@ -13,12 +20,28 @@ enum class GameState {
     NO_MOVES
 };
 
+struct GameOptions {
+    // Runs the fixed simulation steps on their own thread instead of
+    // between frames
+    bool threadedSimulation = false;
+    // Random when unset
+    std::optional<uint64_t> seed;
+    // Save the game to this file on exit (see Replay.h)
+    std::string recordPath;
+    // Play this recorded game instead of taking input
+    std::string replayPath;
+};
+
 class Game {
 public:
     Game();
     ~Game();
 
-    bool init();
+    // Logic and animation advance in fixed steps of 1/SIMULATION_RATE
+    // seconds whatever the frame rate, so play is deterministic
+    static constexpr int SIMULATION_RATE = 120;
+
+    bool init(const GameOptions& options = GameOptions());
     void run();
     void cleanup();
 
@@ -28,14 +51,38 @@ private:
     std::unique_ptr<Grid> grid;
     std::unique_ptr<Renderer> gameRenderer;
     std::unique_ptr<InputHandler> inputHandler;
+    std::unique_ptr<MoveSearcher> moveSearcher;
 
-    bool running;
+    std::atomic<bool> running;
+    bool autoPlay;  // Toggled with A: the searcher plays every move
     GameState state;
-    Uint64 lastTime;
+    Uint64 lastTime;       // Nanoseconds, start of the previous frame
+    float accumulator;     // Seconds not yet simulated (inline simulation)
+
+    // Threaded simulation. The mutex guards everything the steps touch
+    // (grid, input, state); the main thread holds it to handle events and
+    // to draw.
+    bool threadedSimulation;
+    std::thread simulationThread;
+    std::mutex simulationMutex;
+    Uint64 lastStepTime;  // Nanoseconds, scheduled time of the latest step
+
+    // Replays. Swaps are stamped with stepCount, the number of simulation
+    // steps run so far.
+    uint64_t stepCount;
+    Replay replay;          // Being recorded, or being played back
+    bool recording;
+    bool replaying;
+    size_t nextReplaySwap;  // Playback position in replay.swaps
+    std::string recordPath;
 
     void handleEvents();
     void update(float deltaTime);
-    void render();
+    void render(float blend);
+    void runSimulation();
     void processInput();
+    bool applySwap(const Move& move);
+    void playReplaySwaps();
+    void showHint();
     void updateGameLogic(float deltaTime);
 };
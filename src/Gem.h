@@ -1,8 +1,9 @@
 #pragma once
 
 #include "BoardTypes.h"
+#include <cstdint>
 
-enum class GemState {
+enum class GemState : uint8_t {
     IDLE,
     FALLING,
     SWAPPING,
@@ -11,37 +12,47 @@ enum class GemState {
     READY_FOR_REMOVAL
 };
 
+class GemPool;
+
+// View of one gem stored in a GemPool. The gem's fields live in the pool's
+// per-field arrays, so a Gem is only a pool pointer and a slot: cheap to copy,
+// valid until the gem is released. A default-constructed Gem refers to no gem
+// and converts to false. Member functions are defined in GemPool.h.
 class Gem {
 public:
-    Gem(int row, int col, GemType type);
+    Gem() = default;
+    Gem(GemPool* pool, uint16_t slot) : pool(pool), slot(slot) {}
+
+    explicit operator bool() const { return pool != nullptr; }
+
+    GemType getType() const;
+    GemState getState() const;
+    void setState(GemState newState);
 
-    GemType getType() const { return type; }
-    GemState getState() const { return state; }
-    void setState(GemState newState) { state = newState; }
+    int getRow() const;
+    int getCol() const;
+    void setRow(int r);
+    void setCol(int c);
 
-    int getRow() const { return row; }
-    int getCol() const { return col; }
-    void setRow(int r) { row = r; }
-    void setCol(int c) { col = c; }
+    float getX() const;
+    float getY() const;
+    void setX(float newX);
+    void setY(float newY);
 
-    float getX() const { return x; }
-    float getY() const { return y; }
-    void setX(float newX) { x = newX; }
-    void setY(float newY) { y = newY; }
+    // Position between the last two GemPool updates: blend 0 is the
+    // position before the last update, 1 the current one
+    float getRenderX(float blend) const;
+    float getRenderY(float blend) const;
 
-    int getTargetRow() const { return targetRow; }
-    int getTargetCol() const { return targetCol; }
-    void setTarget(int r, int c) { targetRow = r; targetCol = c; }
+    int getTargetRow() const;
+    int getTargetCol() const;
+    void setTarget(int r, int c);
 
-    void update(float deltaTime);
+    // 0 to 1 through the current swap, fall or explosion
+    float getAnimationProgress() const;
     bool isAnimating() const;
 
 private:
-    GemType type;
-    GemState state;
-    int row, col;
-    int targetRow, targetCol;
-    float x, y;
-    float startX, startY;  // Starting positions for animation
-    float animationProgress;
+    GemPool* pool = nullptr;
+    uint16_t slot = 0;
 };
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "BoardTypes.h"
+#include "Random.h"
+#include <utility>
+#include <vector>
+
+// Gem generators for the templated initializeBoard, fillEmpty and
+// executeSequence overloads of BoardLogic. A generator is any callable
+// GemType(int row, int col); BoardLogic calls it by reference and directly,
+// so these inline into the refill loop. A GemFactory also works, at the
+// cost of an indirect call per gem.
+
+// Always the same gem type. ConstantGems{GemType::EMPTY} leaves refills
+// empty, for evaluating a move without guessing unknown gems.
+struct ConstantGems {
+    GemType type;
+
+    GemType operator()(int, int) const { return type; }
+};
+
+// Cycles through a fixed, non-empty sequence
+class SequenceGems {
+public:
+    explicit SequenceGems(std::vector<GemType> sequence) : sequence(std::move(sequence)) {}
+
+    GemType operator()(int, int) {
+        GemType type = sequence[next];
+        if (++next == sequence.size()) next = 0;
+        return type;
+    }
+
+private:
+    std::vector<GemType> sequence;
+    size_t next = 0;
+};
+
+// Uniformly random gems from the first Colors types, from its own seed
+template <int Colors = static_cast<int>(GemType::COUNT)>
+class RandomGems {
+public:
+    explicit RandomGems(uint64_t seed) : rng(seed) {}
+
+    GemType operator()(int, int) { return static_cast<GemType>(rng.below(Colors)); }
+
+private:
+    Xoshiro256 rng;
+};
@@ -0,0 +1,143 @@
+#include "GemPool.h"
+#include "MathUtils.h"
+#include <algorithm>
+
+GemPool::GemPool(size_t capacity)
+    : types(capacity, GemType::EMPTY)
+    , states(capacity, GemState::IDLE)
+    , rows(capacity, 0)
+    , cols(capacity, 0)
+    , x(capacity, 0.0f)
+    , y(capacity, 0.0f)
+    , previousX(capacity, 0.0f)
+    , previousY(capacity, 0.0f)
+    , startX(capacity, 0.0f)
+    , startY(capacity, 0.0f)
+    , targetX(capacity, 0.0f)
+    , targetY(capacity, 0.0f)
+    , progress(capacity, 0.0f)
+    , speed(capacity, 0.0f)
+    , moving(capacity, 0.0f)
+    , activeIndex(capacity, NOT_ACTIVE)
+    , generations(capacity, 0)
+    , live(capacity, false) {
+    activeSlots.reserve(capacity);
+    settling.reserve(capacity);
+    freeSlots.reserve(capacity);
+    // Hand out low slots first
+    for (size_t i = capacity; i > 0; --i) {
+        freeSlots.push_back(static_cast<uint16_t>(i - 1));
+    }
+}
+
+GemHandle GemPool::acquire(int row, int col, GemType type) {
+    if (freeSlots.empty()) {
+        return GemHandle{};
+    }
+
+    uint16_t index = freeSlots.back();
+    freeSlots.pop_back();
+
+    types[index] = type;
+    rows[index] = row;
+    cols[index] = col;
+    x[index] = previousX[index] = startX[index] = targetX[index] = static_cast<float>(col);
+    y[index] = previousY[index] = startY[index] = targetY[index] = static_cast<float>(row);
+    setState(index, GemState::IDLE);
+    live[index] = true;
+    return GemHandle{index, generations[index]};
+}
+
+void GemPool::release(GemHandle handle) {
+    if (!get(handle)) return;
+
+    // Dead slots must not animate
+    setState(handle.index, GemState::IDLE);
+    live[handle.index] = false;
+    ++generations[handle.index];
+    freeSlots.push_back(handle.index);
+}
+
+Gem GemPool::get(GemHandle handle) {
+    if (handle.index >= live.size() || !live[handle.index] ||
+        generations[handle.index] != handle.generation) {
+        return Gem();
+    }
+    return Gem(this, handle.index);
+}
+
+Gem GemPool::get(GemHandle handle) const {
+    return const_cast<GemPool*>(this)->get(handle);
+}
+
+void GemPool::update(float deltaTime) {
+    for (uint16_t slot : settling) {
+        previousX[slot] = x[slot];
+        previousY[slot] = y[slot];
+    }
+    settling.clear();
+
+    for (uint16_t slot : activeSlots) {
+        previousX[slot] = x[slot];
+        previousY[slot] = y[slot];
+
+        float t = std::min(progress[slot] + deltaTime * speed[slot], 1.0f);
+        progress[slot] = t;
+
+        // Exploding gems have zero weight and stay put
+        float smoothT = MathUtils::smoothstep(t);
+        x[slot] += moving[slot] * (MathUtils::lerp(startX[slot], targetX[slot], smoothT) - x[slot]);
+        y[slot] += moving[slot] * (MathUtils::lerp(startY[slot], targetY[slot], smoothT) - y[slot]);
+    }
+
+    // Walk backwards: finishing removes the slot by swapping in the last
+    // entry, which has already been checked
+    for (size_t i = activeSlots.size(); i > 0; --i) {
+        uint16_t slot = activeSlots[i - 1];
+        if (progress[slot] >= 1.0f) {
+            finishAnimation(slot);
+            settling.push_back(slot);
+        }
+    }
+}
+
+void GemPool::setState(uint16_t slot, GemState state) {
+    bool moves = state == GemState::FALLING || state == GemState::SWAPPING;
+    bool explodes = state == GemState::EXPLODING;
+
+    states[slot] = state;
+    moving[slot] = moves ? 1.0f : 0.0f;
+    speed[slot] = moves ? MOVE_SPEED : explodes ? EXPLODE_SPEED : 0.0f;
+
+    // Animations start from wherever the gem is now
+    progress[slot] = 0.0f;
+    startX[slot] = x[slot];
+    startY[slot] = y[slot];
+
+    bool active = activeIndex[slot] != NOT_ACTIVE;
+    if (speed[slot] > 0.0f && !active) {
+        activeIndex[slot] = static_cast<uint16_t>(activeSlots.size());
+        activeSlots.push_back(slot);
+    } else if (speed[slot] == 0.0f && active) {
+        uint16_t last = activeSlots.back();
+        activeSlots[activeIndex[slot]] = last;
+        activeIndex[last] = activeIndex[slot];
+        activeSlots.pop_back();
+        activeIndex[slot] = NOT_ACTIVE;
+    }
+}
+
+void GemPool::finishAnimation(uint16_t slot) {
+    if (states[slot] == GemState::EXPLODING) {
+        setState(slot, GemState::READY_FOR_REMOVAL);
+        progress[slot] = 1.0f;
+        return;
+    }
+
+    // Snap to the target so rounding in the last step never leaves a gem off its cell
+    rows[slot] = static_cast<int>(targetY[slot]);
+    cols[slot] = static_cast<int>(targetX[slot]);
+    x[slot] = targetX[slot];
+    y[slot] = targetY[slot];
+    setState(slot, GemState::IDLE);
+}
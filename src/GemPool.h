@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Gem.h"
+#include <cstdint>
+#include <vector>
+
+// Handle to a pooled Gem. The generation changes every time a slot is
+// released, so a stale handle resolves to an empty Gem instead of to
+// whichever gem reuses the slot.
+struct GemHandle {
+    static const uint16_t INVALID = 0xFFFF;
+
+    uint16_t index = INVALID;
+    uint16_t generation = 0;
+
+    explicit operator bool() const { return index != INVALID; }
+    bool operator==(const GemHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const GemHandle& other) const { return !(*this == other); }
+};
+
+// Fixed pool of gems with a free list. All storage is allocated up front, so
+// acquiring and releasing gems during cascades never touches the heap.
+//
+// Gems are stored as a structure of arrays: each field has its own
+// contiguous array indexed by slot. The pool also tracks which slots are
+// swapping, falling or exploding, so update() touches only those and
+// isAnimating() is a size check; an idle board costs nothing per frame.
+class GemPool {
+public:
+    // Animation rates in progress per second. An animation completes when its
+    // progress reaches 1, so a swap or fall takes about 1/MOVE_SPEED seconds.
+    static constexpr float MOVE_SPEED = 3.0f;  // ~0.33 second animation time
+    static constexpr float EXPLODE_SPEED = 2.0f;
+
+    explicit GemPool(size_t capacity);
+
+    // Returns an invalid handle when every slot is in use
+    GemHandle acquire(int row, int col, GemType type);
+    void release(GemHandle handle);
+
+    // Returns an empty Gem for invalid or stale handles
+    Gem get(GemHandle handle);
+    Gem get(GemHandle handle) const;
+
+    // Advances every swapping, falling and exploding gem. Positions before
+    // the step are kept for Gem::getRenderX/Y.
+    void update(float deltaTime);
+    bool isAnimating() const { return !activeSlots.empty(); }
+    size_t animatingCount() const { return activeSlots.size(); }
+
+    size_t size() const { return live.size() - freeSlots.size(); }
+    size_t capacity() const { return live.size(); }
+
+private:
+    friend class Gem;
+
+    std::vector<GemType> types;
+    std::vector<GemState> states;
+    std::vector<int> rows, cols;
+    std::vector<float> x, y;
+    std::vector<float> previousX, previousY;  // Position before the last update()
+    std::vector<float> startX, startY;  // Position when the animation began
+    std::vector<float> targetX, targetY;
+    std::vector<float> progress;
+    std::vector<float> speed;   // Progress per second; 0 when not animating
+    std::vector<float> moving;  // 1 while swapping or falling, else 0
+
+    // Slots with a running animation, unordered, and each slot's position in
+    // that list (NOT_ACTIVE when idle)
+    static constexpr uint16_t NOT_ACTIVE = 0xFFFF;
+    std::vector<uint16_t> activeSlots;
+    std::vector<uint16_t> activeIndex;
+    // Slots that finished during the last update(); their previous position
+    // catches up at the start of the next one
+    std::vector<uint16_t> settling;
+
+    std::vector<uint16_t> generations;
+    std::vector<uint16_t> freeSlots;  // Stack of unused slot indices
+    std::vector<bool> live;
+
+    void setState(uint16_t slot, GemState state);
+    void finishAnimation(uint16_t slot);
+};
+
+inline GemType Gem::getType() const { return pool->types[slot]; }
+inline GemState Gem::getState() const { return pool->states[slot]; }
+inline void Gem::setState(GemState newState) { pool->setState(slot, newState); }
+
+inline int Gem::getRow() const { return pool->rows[slot]; }
+inline int Gem::getCol() const { return pool->cols[slot]; }
+inline void Gem::setRow(int r) { pool->rows[slot] = r; }
+inline void Gem::setCol(int c) { pool->cols[slot] = c; }
+
+inline float Gem::getX() const { return pool->x[slot]; }
+inline float Gem::getY() const { return pool->y[slot]; }
+// Setting a position jumps there, without interpolating from the old one
+inline void Gem::setX(float newX) { pool->x[slot] = pool->previousX[slot] = newX; }
+inline void Gem::setY(float newY) { pool->y[slot] = pool->previousY[slot] = newY; }
+
+inline float Gem::getRenderX(float blend) const {
+    return pool->previousX[slot] + (pool->x[slot] - pool->previousX[slot]) * blend;
+}
+inline float Gem::getRenderY(float blend) const {
+    return pool->previousY[slot] + (pool->y[slot] - pool->previousY[slot]) * blend;
+}
+
+inline int Gem::getTargetRow() const { return static_cast<int>(pool->targetY[slot]); }
+inline int Gem::getTargetCol() const { return static_cast<int>(pool->targetX[slot]); }
+inline void Gem::setTarget(int r, int c) {
+    pool->targetX[slot] = static_cast<float>(c);
+    pool->targetY[slot] = static_cast<float>(r);
+}
+
+inline float Gem::getAnimationProgress() const { return pool->progress[slot]; }
+inline bool Gem::isAnimating() const { return pool->speed[slot] > 0.0f; }
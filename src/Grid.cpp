@@ -1,12 +1,11 @@
 #include "Grid.h"
+#include "Profiler.h"
 #include <algorithm>
+#include <cassert>
 
-Grid::Grid() {
-    gems.resize(ROWS);
-    for (int row = 0; row < ROWS; ++row) {
-        gems[row].resize(COLS);
-    }
-
+Grid::Grid(uint64_t seed)
+    : gemPool(ROWS * COLS)
+    , boardLogic(seed) {
     // Initialize board state using BoardLogic (avoids initial matches)
     boardLogic.initializeBoard(boardState);
 
@@ -19,29 +18,17 @@ Grid::Grid() {
 }
 
 void Grid::update(float deltaTime) {
-    for (int row = 0; row < ROWS; ++row) {
-        for (int col = 0; col < COLS; ++col) {
-            if (gems[row][col]) {
-                gems[row][col]->update(deltaTime);
-            }
-        }
-    }
+    PROFILE_SCOPE("Grid::update");
+    gemPool.update(deltaTime);
 }
 
 bool Grid::isAnimating() const {
-    for (int row = 0; row < ROWS; ++row) {
-        for (int col = 0; col < COLS; ++col) {
-            if (gems[row][col] && gems[row][col]->isAnimating()) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return gemPool.isAnimating();
 }
 
-Gem* Grid::getGem(int row, int col) const {
-    if (!isValidPosition(row, col)) return nullptr;
-    return gems[row][col].get();
+Gem Grid::getGem(int row, int col) const {
+    if (!isValidPosition(row, col)) return Gem();
+    return gemPool.get(cell(row, col));
 }
 
 bool Grid::swapGems(int row1, int col1, int row2, int col2) {
@@ -53,120 +40,122 @@ bool Grid::swapGems(int row1, int col1, int row2, int col2) {
         return false;
     }
 
-    Gem* gem1 = gems[row1][col1].get();
-    Gem* gem2 = gems[row2][col2].get();
+    Gem gem1 = gemAt(row1, col1);
+    Gem gem2 = gemAt(row2, col2);
 
     if (!gem1 || !gem2) return false;
 
     // Swap in grid and board state
-    std::swap(gems[row1][col1], gems[row2][col2]);
-    std::swap(boardState.at(row1, col1), boardState.at(row2, col2));
+    std::swap(cell(row1, col1), cell(row2, col2));
+    boardState.swap(row1, col1, row2, col2);
+    dirtyCells |= BoardState::bit(row1, col1) | BoardState::bit(row2, col2);
 
     // Update gem positions and trigger animation
-    gem1->setRow(row2);
-    gem1->setCol(col2);
-    gem1->setTarget(row2, col2);
-    gem1->setState(GemState::SWAPPING);
+    gem1.setRow(row2);
+    gem1.setCol(col2);
+    gem1.setTarget(row2, col2);
+    gem1.setState(GemState::SWAPPING);
 
-    gem2->setRow(row1);
-    gem2->setCol(col1);
-    gem2->setTarget(row1, col1);
-    gem2->setState(GemState::SWAPPING);
+    gem2.setRow(row1);
+    gem2.setCol(col1);
+    gem2.setTarget(row1, col1);
+    gem2.setState(GemState::SWAPPING);
 
     return true;
 }
 
 void Grid::checkMatches() {
-    auto result = boardLogic.checkMatches(boardState);
+    // Only runs through cells changed by the last swap, gravity or refill
+    // can be new
+    auto result = boardLogic.checkMatches(boardState, dirtyCells);
+    dirtyCells = 0;
 
-    matchedPositions.clear();
-    for (const auto& pos : result.matchedPositions) {
-        matchedPositions.push_back({pos.row, pos.col});
-    }
+    matchedPositions = result.matchedPositions;
 }
 
 void Grid::removeMatches() {
     if (matchedPositions.empty()) return;
 
-    // Convert to Position vector for BoardLogic
-    std::vector<Position> positions;
-    for (const auto& pos : matchedPositions) {
-        positions.push_back({pos.first, pos.second});
-    }
-
     // Update score before removing
-    boardState.score += static_cast<int>(positions.size()) * 10;
+    boardState.score += static_cast<int>(matchedPositions.size()) * 10;
 
     // Set gems to exploding state (for animation)
     for (const auto& pos : matchedPositions) {
-        int row = pos.first;
-        int col = pos.second;
-        if (gems[row][col]) {
-            gems[row][col]->setState(GemState::EXPLODING);
+        if (Gem gem = gemAt(pos.row, pos.col)) {
+            gem.setState(GemState::EXPLODING);
         }
     }
 
     // Update board state
-    boardLogic.removeMatches(boardState, positions);
+    boardLogic.removeMatches(boardState, matchedPositions);
 }
 
 void Grid::applyGravity() {
     // Remove gems that are ready for removal (finished exploding)
     for (int row = 0; row < ROWS; ++row) {
         for (int col = 0; col < COLS; ++col) {
-            if (gems[row][col] && gems[row][col]->getState() == GemState::READY_FOR_REMOVAL) {
-                gems[row][col].reset();
+            Gem gem = gemAt(row, col);
+            if (gem && gem.getState() == GemState::READY_FOR_REMOVAL) {
+                releaseGem(row, col);
             }
         }
     }
 
     // Compute gravity moves using BoardLogic
     auto result = boardLogic.applyGravity(boardState);
+    dirtyCells |= result.dirty;
 
     // Apply moves to Gem objects with animation
     for (const auto& move : result.moves) {
         int fromRow = move.from.row, fromCol = move.from.col;
         int toRow = move.to.row, toCol = move.to.col;
 
-        gems[toRow][toCol] = std::move(gems[fromRow][fromCol]);
-        gems[toRow][toCol]->setRow(toRow);
-        gems[toRow][toCol]->setCol(toCol);
-        gems[toRow][toCol]->setTarget(toRow, toCol);
-        gems[toRow][toCol]->setState(GemState::FALLING);
+        // The destination may still hold a gem that is exploding
+        gemPool.release(cell(toRow, toCol));
+        cell(toRow, toCol) = cell(fromRow, fromCol);
+        cell(fromRow, fromCol) = GemHandle{};
+        if (Gem gem = gemAt(toRow, toCol)) {
+            gem.setRow(toRow);
+            gem.setCol(toCol);
+            gem.setTarget(toRow, toCol);
+            gem.setState(GemState::FALLING);
+        }
     }
 }
 
 void Grid::fillEmpty() {
     // Collect empty positions
-    std::vector<Position> emptyPositions;
+    StaticVector<Position, ROWS * COLS> emptyPositions;
     for (int row = 0; row < ROWS; ++row) {
         for (int col = 0; col < COLS; ++col) {
-            if (!gems[row][col]) {
+            if (!gemAt(row, col)) {
                 emptyPositions.push_back({row, col});
             }
         }
     }
 
     // Fill empty positions in board state
-    boardLogic.fillEmpty(boardState, emptyPositions);
+    dirtyCells |= boardLogic.fillEmpty(boardState, emptyPositions);
 
     // Create Gem objects for filled positions
     for (const auto& pos : emptyPositions) {
         syncBoardToGem(pos.row, pos.col);
-        gems[pos.row][pos.col]->setY(-1.0f);
-        gems[pos.row][pos.col]->setTarget(pos.row, pos.col);
-        gems[pos.row][pos.col]->setState(GemState::FALLING);
+        if (Gem gem = gemAt(pos.row, pos.col)) {
+            gem.setY(-1.0f);
+            gem.setTarget(pos.row, pos.col);
+            gem.setState(GemState::FALLING);
+        }
     }
 }
 
-void Grid::createGem(int row, int col) {
-    GemType type = boardState.at(row, col);
-    gems[row][col] = std::make_unique<Gem>(row, col, type);
+void Grid::releaseGem(int row, int col) {
+    gemPool.release(cell(row, col));
+    cell(row, col) = GemHandle{};
 }
 
 void Grid::syncGemToBoard(int row, int col) {
-    if (gems[row][col]) {
-        boardState.at(row, col) = gems[row][col]->getType();
+    if (Gem gem = gemAt(row, col)) {
+        boardState.at(row, col) = gem.getType();
     } else {
         boardState.at(row, col) = GemType::EMPTY;
     }
@@ -174,10 +163,11 @@ void Grid::syncGemToBoard(int row, int col) {
 
 void Grid::syncBoardToGem(int row, int col) {
     GemType type = boardState.at(row, col);
+    releaseGem(row, col);
     if (type != GemType::EMPTY) {
-        gems[row][col] = std::make_unique<Gem>(row, col, type);
-    } else {
-        gems[row][col].reset();
+        cell(row, col) = gemPool.acquire(row, col, type);
+        // The pool has a slot per cell, so running out means a leaked gem
+        assert(cell(row, col));
     }
 }
 
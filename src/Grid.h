@@ -1,9 +1,8 @@
 #pragma once
 
 #include "Gem.h"
+#include "GemPool.h"
 #include "BoardLogic.h"
-#include <vector>
-#include <memory>
 
 class Grid {
 public:
@@ -11,12 +10,15 @@ public:
     static const int ROWS = BoardState::ROWS;
     static const int COLS = BoardState::COLS;
 
-    Grid();
+    // The seed drives the initial board and all new gems, so the same seed
+    // and the same swaps replay the same game
+    explicit Grid(uint64_t seed);
 
     void update(float deltaTime);
     bool isAnimating() const;
 
-    Gem* getGem(int row, int col) const;
+    // Empty Gem for empty cells or positions off the board
+    Gem getGem(int row, int col) const;
     bool swapGems(int row1, int col1, int row2, int col2);
     void checkMatches();
     void removeMatches();
@@ -24,17 +26,26 @@ public:
     void fillEmpty();
 
     int getScore() const { return boardState.score; }
+    // Pooled gems in use, exploding ones included
+    size_t gemCount() const { return gemPool.size(); }
     bool hasValidMoves() const;
 
     const BoardState& getBoardState() const { return boardState; }
 
 private:
-    std::vector<std::vector<std::unique_ptr<Gem>>> gems;
-    std::vector<std::pair<int, int>> matchedPositions;
+    // Gems live in a pool sized for a full board; cells hold handles to them
+    // in row-major order
+    GemPool gemPool;
+    GemHandle cells[ROWS * COLS];
+    StaticVector<Position, ROWS * COLS> matchedPositions;
     BoardState boardState;
     BoardLogic boardLogic;
+    Bitboard dirtyCells = 0;  // Cells changed since the last checkMatches()
 
-    void createGem(int row, int col);
+    GemHandle& cell(int row, int col) { return cells[row * COLS + col]; }
+    const GemHandle& cell(int row, int col) const { return cells[row * COLS + col]; }
+    Gem gemAt(int row, int col) { return gemPool.get(cell(row, col)); }
+    void releaseGem(int row, int col);
     void syncGemToBoard(int row, int col);
     void syncBoardToGem(int row, int col);
     bool isValidPosition(int row, int col) const;
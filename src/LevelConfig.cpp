@@ -0,0 +1,51 @@
+#include "LevelConfig.h"
+#include <fstream>
+#include <sstream>
+
+std::optional<LevelConfig> parseLevelConfig(std::istream& in) {
+    LevelConfig level;
+    std::string line;
+
+    while (std::getline(in, line)) {
+        // Strip comments
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                return std::nullopt;  // Not blank and not key = value
+            }
+            continue;
+        }
+
+        std::istringstream keyStream(line.substr(0, equals));
+        std::istringstream valueStream(line.substr(equals + 1));
+        std::string key;
+        int value = 0;
+        keyStream >> key;
+
+        int* field = nullptr;
+        if (key == "rows") field = &level.rows;
+        else if (key == "cols") field = &level.cols;
+        else if (key == "colors") field = &level.colors;
+        if (!field) continue;
+
+        if (!(valueStream >> value) || value <= 0) {
+            return std::nullopt;
+        }
+        *field = value;
+    }
+
+    return level;
+}
+
+std::optional<LevelConfig> loadLevelConfig(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    return parseLevelConfig(file);
+}
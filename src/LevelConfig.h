@@ -0,0 +1,46 @@
+#pragma once
+
+#include "BoardLogic.h"
+#include <istream>
+#include <optional>
+#include <string>
+
+// Board shape of a level, read from a level file:
+//
+//   # comment
+//   rows = 9
+//   cols = 9
+//   colors = 5
+//
+// Missing keys keep the standard 8x8, six-color defaults. Unknown keys are
+// ignored so level files can carry data for other systems.
+struct LevelConfig {
+    int rows = BoardState::ROWS;
+    int cols = BoardState::COLS;
+    int colors = BoardState::COLORS;
+};
+
+std::optional<LevelConfig> parseLevelConfig(std::istream& in);
+std::optional<LevelConfig> loadLevelConfig(const std::string& path);
+
+// Compile-time board shape handed to visitBoardShape() visitors
+template <int Rows, int Cols, int Colors>
+struct BoardShape {
+    using State = BasicBoardState<Rows, Cols, Colors>;
+    using Logic = BasicBoardLogic<Rows, Cols, Colors>;
+};
+
+// Call visitor(BoardShape<R, C, K>{}) for the compiled shape matching the
+// level, so the visitor runs with constant board dimensions. Returns false
+// when the level's shape is not in MATCH3_BOARD_SHAPES.
+template <typename Visitor>
+bool visitBoardShape(const LevelConfig& level, Visitor&& visitor) {
+#define MATCH3_VISIT_BOARD_SHAPE(R, C, K) \
+    if (level.rows == R && level.cols == C && level.colors == K) { \
+        visitor(BoardShape<R, C, K>{}); \
+        return true; \
+    }
+    MATCH3_BOARD_SHAPES(MATCH3_VISIT_BOARD_SHAPE)
+#undef MATCH3_VISIT_BOARD_SHAPE
+    return false;
+}
@@ -0,0 +1,170 @@
+#include "MoveSearcher.h"
+#include "GemGenerators.h"
+#include "Random.h"
+#include <algorithm>
+
+namespace {
+
+// Check the clock once per this many sequences
+const uint64_t CLOCK_CHECK_INTERVAL = 32;
+
+// Mixed into the board hash so each depth caches its own value
+uint64_t depthKey(int depth) {
+    uint64_t state = 0xD3E9ull + static_cast<uint64_t>(depth);
+    return splitMix64(state);
+}
+
+// Refill seed for one sample of one move, independent of search order
+uint64_t sampleSeed(uint64_t seed, uint64_t boardHash, const Move& move, int sample) {
+    uint64_t state = seed ^ boardHash;
+    state ^= static_cast<uint64_t>((move.from.row << 12) | (move.from.col << 8) |
+                                   (move.to.row << 4) | move.to.col) << 32;
+    state += static_cast<uint64_t>(sample);
+    return splitMix64(state);
+}
+
+} // namespace
+
+template <typename Logic>
+BasicMoveSearcher<Logic>::BasicMoveSearcher(const SearchConfig& config)
+    : config(config)
+    , logic(config.seed)
+    , table(config.tableEntries) {
+    if (config.threads != 1) {
+        pool = std::make_unique<ThreadPool>(config.threads);
+    }
+}
+
+template <typename Logic>
+SearchResult BasicMoveSearcher<Logic>::search(const State& state) {
+    auto start = Clock::now();
+    SearchResult result;
+
+    std::vector<Move> rootMoves;
+    logic.enumerateValidMoves(state, rootMoves);
+    if (rootMoves.empty()) {
+        return result;
+    }
+
+    Clock::time_point deadline = config.timeBudgetMs > 0.0
+        ? start + std::chrono::duration_cast<Clock::duration>(
+              std::chrono::duration<double, std::milli>(config.timeBudgetMs))
+        : Clock::time_point::max();
+    std::vector<int> values(rootMoves.size());
+    std::atomic<uint64_t> sequences{0};
+    expired = false;
+
+    for (int depth = 1; depth <= std::max(1, config.maxDepth); ++depth) {
+        auto searchMove = [&, depth](size_t index) {
+            Context context;
+            context.deadline = deadline;
+            context.enforceDeadline = depth > 1;
+            context.moves.resize(static_cast<size_t>(depth));
+            values[index] = chanceValue(state, rootMoves[index], depth, context);
+            sequences += context.sequences;
+        };
+
+        if (pool) {
+            for (size_t i = 0; i < rootMoves.size(); ++i) {
+                pool->submit([&searchMove, i] { searchMove(i); });
+            }
+            pool->wait();
+        } else {
+            for (size_t i = 0; i < rootMoves.size() && !expired; ++i) {
+                searchMove(i);
+            }
+        }
+
+        if (depth > 1 && expired) {
+            break;  // Keep the last complete depth
+        }
+
+        // Ties go to the first move in row-major order
+        size_t best = 0;
+        for (size_t i = 1; i < values.size(); ++i) {
+            if (values[i] > values[best]) best = i;
+        }
+        result.found = true;
+        result.bestMove = rootMoves[best];
+        result.expectedScore = values[best];
+        result.depth = depth;
+
+        if (Clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    result.sequences = sequences;
+    result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+template <typename Logic>
+int BasicMoveSearcher<Logic>::maxValue(const State& state, int depth, Context& context) {
+    if (depth == 0) {
+        return 0;
+    }
+
+    const uint64_t key = state.hash() ^ depthKey(depth);
+    if (auto cached = table.probe(key)) {
+        return cached->score;
+    }
+
+    // This depth's scratch list stays untouched while deeper levels run
+    auto& moves = context.moves[static_cast<size_t>(depth - 1)];
+    logic.enumerateValidMoves(state, moves);
+
+    TranspositionTable::Entry entry;
+    entry.depth = static_cast<uint8_t>(depth);
+    entry.validMoves = static_cast<uint8_t>(std::min<size_t>(moves.size(), 255));
+    for (const Move& move : moves) {
+        int value = chanceValue(state, move, depth, context);
+        if (expired) {
+            return 0;  // Partial values are never cached
+        }
+        if (!entry.hasBestMove || value > entry.score) {
+            entry.hasBestMove = true;
+            entry.bestMove = move;
+            entry.score = value;
+        }
+    }
+
+    table.store(key, entry);
+    return entry.score;
+}
+
+template <typename Logic>
+int BasicMoveSearcher<Logic>::chanceValue(const State& state, const Move& move, int depth, Context& context) {
+    const int samples = std::max(1, config.chanceSamples);
+    int64_t total = 0;
+    for (int sample = 0; sample < samples; ++sample) {
+        if (outOfTime(context)) {
+            return 0;
+        }
+
+        State child = state;
+        RandomGems<State::COLORS> refills(sampleSeed(config.seed, state.hash(), move, sample));
+        logic.executeSequence(child, move, refills, context.sequence);
+        total += context.sequence.totalScore;
+        ++context.sequences;
+
+        total += maxValue(child, depth - 1, context);
+    }
+    return static_cast<int>(total / samples);
+}
+
+template <typename Logic>
+bool BasicMoveSearcher<Logic>::outOfTime(Context& context) {
+    if (expired) {
+        return true;
+    }
+    if (context.enforceDeadline && context.sequences % CLOCK_CHECK_INTERVAL == 0 &&
+        Clock::now() >= context.deadline) {
+        expired = true;
+    }
+    return expired;
+}
+
+#define MATCH3_INSTANTIATE_MOVE_SEARCHER(R, C, K) template class BasicMoveSearcher<BasicBoardLogic<R, C, K>>;
+MATCH3_BOARD_SHAPES(MATCH3_INSTANTIATE_MOVE_SEARCHER)
+#undef MATCH3_INSTANTIATE_MOVE_SEARCHER
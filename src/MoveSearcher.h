@@ -0,0 +1,76 @@
+#pragma once
+
+#include "BoardLogic.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct SearchConfig {
+    int maxDepth = 3;           // Plies (moves) to look ahead
+    int chanceSamples = 4;      // Refills sampled per chance node
+    double timeBudgetMs = 8.0;  // Deepening stops when spent; <= 0 means no limit
+    unsigned threads = 0;       // 0 = one per hardware core, 1 = search inline
+    uint64_t seed = 1;          // Refill samples derive from seed and position
+    size_t tableEntries = 1 << 16;
+};
+
+struct SearchResult {
+    bool found = false;     // False when the board has no valid move
+    Move bestMove{};
+    int expectedScore = 0;  // Expected points over `depth` moves
+    int depth = 0;          // Deepest fully searched depth
+    uint64_t sequences = 0; // executeSequence calls made
+    double elapsedMs = 0.0;
+};
+
+// Best-move search by expectimax over cascades. A max node tries every
+// valid swap; a chance node plays the swap on copies of the board with
+// sampled refills and averages the score plus the best follow-up. Root
+// moves are searched in parallel, one depth at a time, until the time
+// budget runs out; depth 1 always completes so a move is always found.
+// Values are integers and samples are seeded from the position, so the
+// result does not depend on thread count or timing within a depth.
+template <typename Logic>
+class BasicMoveSearcher {
+public:
+    using State = typename Logic::State;
+
+    explicit BasicMoveSearcher(const SearchConfig& config = SearchConfig());
+
+    SearchResult search(const State& state);
+
+    const SearchConfig& getConfig() const { return config; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Per-task search state
+    struct Context {
+        Clock::time_point deadline;
+        bool enforceDeadline = false;
+        uint64_t sequences = 0;
+        std::vector<std::vector<Move>> moves;  // Scratch list per depth
+        typename Logic::SequenceResult sequence;  // Reused by every simulation
+    };
+
+    SearchConfig config;
+    Logic logic;
+    std::unique_ptr<ThreadPool> pool;  // Null when searching inline
+    TranspositionTable table;
+    std::atomic<bool> expired{false};
+
+    int maxValue(const State& state, int depth, Context& context);
+    int chanceValue(const State& state, const Move& move, int depth, Context& context);
+    bool outOfTime(Context& context);
+};
+
+#define MATCH3_EXTERN_MOVE_SEARCHER(R, C, K) extern template class BasicMoveSearcher<BasicBoardLogic<R, C, K>>;
+MATCH3_BOARD_SHAPES(MATCH3_EXTERN_MOVE_SEARCHER)
+#undef MATCH3_EXTERN_MOVE_SEARCHER
+
+// Searcher for the standard 8x8 rules used by the game
+using MoveSearcher = BasicMoveSearcher<BoardLogic>;
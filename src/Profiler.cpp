@@ -0,0 +1,111 @@
+#include "Profiler.h"
+#include <cstdio>
+
+namespace {
+
+std::atomic<uint32_t> nextThread{0};
+
+} // namespace
+
+Profiler::Profiler()
+    : origin(std::chrono::steady_clock::now())
+    , slots(CAPACITY) {
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::now() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin).count());
+}
+
+uint32_t Profiler::threadId() {
+    // Shared by every profiler, so a thread keeps one id
+    thread_local uint32_t id = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t durationNs) {
+    uint64_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[index & (CAPACITY - 1)];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(durationNs, std::memory_order_relaxed);
+    slot.thread.store(threadId(), std::memory_order_relaxed);
+    slot.sequence.store(2 * (index + 1), std::memory_order_release);
+}
+
+std::vector<Profiler::Event> Profiler::events() const {
+    uint64_t end = writeIndex.load(std::memory_order_acquire);
+    uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+
+    std::vector<Event> result;
+    result.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t index = begin; index < end; ++index) {
+        const Slot& slot = slots[index & (CAPACITY - 1)];
+        uint64_t expected = 2 * (index + 1);
+        if (slot.sequence.load(std::memory_order_acquire) != expected) {
+            continue;  // Still being written, or already overwritten
+        }
+
+        Event event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.startNs = slot.startNs.load(std::memory_order_relaxed);
+        event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        event.thread = slot.thread.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+            result.push_back(event);
+        }
+    }
+    return result;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::vector<Event> recorded = events();
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < recorded.size(); ++i) {
+        const Event& event = recorded[i];
+        std::fprintf(file, "{\"name\":\"");
+        for (const char* c = event.name; *c; ++c) {
+            if (*c == '"' || *c == '\\') std::fputc('\\', file);
+            std::fputc(*c, file);
+        }
+        // Chrome wants microseconds
+        std::fprintf(file, "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}%s\n",
+                     event.startNs / 1000.0, event.durationNs / 1000.0, event.thread,
+                     i + 1 < recorded.size() ? "," : "");
+    }
+    std::fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+    return std::fclose(file) == 0;
+}
+
+void Profiler::markFrame() {
+    uint64_t time = now();
+    if (lastFrameNs != 0) {
+        frames[frameCount % FRAME_HISTORY] = (time - lastFrameNs) / 1e6f;
+        ++frameCount;
+    }
+    lastFrameNs = time;
+}
+
+std::vector<float> Profiler::frameTimes() const {
+    std::vector<float> result;
+    size_t count = frameCount < FRAME_HISTORY ? frameCount : FRAME_HISTORY;
+    for (size_t i = frameCount - count; i < frameCount; ++i) {
+        result.push_back(frames[i % FRAME_HISTORY]);
+    }
+    return result;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame profiler. Scoped timers record begin/duration events into a fixed
+// lock-free ring buffer, which can be exported as Chrome trace-event JSON
+// (open it in chrome://tracing or ui.perfetto.dev). Frame times are kept
+// separately for an on-screen graph.
+//
+// Instrument code with the PROFILE_* macros, not the class: unless the build
+// defines MATCH3_PROFILING (CMake option ENABLE_PROFILING) they expand to
+// nothing, and the profiler is never instantiated.
+class Profiler {
+public:
+    // Events kept; older ones are overwritten
+    static constexpr size_t CAPACITY = 1 << 16;
+    static constexpr size_t FRAME_HISTORY = 240;
+
+    struct Event {
+        const char* name;   // Must outlive the profiler (string literals)
+        uint64_t startNs;   // Since the profiler was created
+        uint64_t durationNs;
+        uint32_t thread;    // Small id in order of first use
+    };
+
+    Profiler();
+
+    static Profiler& instance();
+
+    uint64_t now() const;
+
+    // Safe to call from any thread
+    void record(const char* name, uint64_t startNs, uint64_t durationNs);
+
+    // Events still in the buffer, oldest first. Events being written
+    // concurrently are skipped.
+    std::vector<Event> events() const;
+    uint64_t recordedCount() const { return writeIndex.load(std::memory_order_relaxed); }
+
+    bool writeChromeTrace(const std::string& path) const;
+
+    // Call once per frame from the main thread
+    void markFrame();
+    // Milliseconds per frame, oldest first; only the main thread may call
+    std::vector<float> frameTimes() const;
+
+private:
+    // Per-slot sequence: odd while being written, 2 * (index + 1) when
+    // event number `index` is complete
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> startNs{0};
+        std::atomic<uint64_t> durationNs{0};
+        std::atomic<uint32_t> thread{0};
+    };
+
+    std::chrono::steady_clock::time_point origin;
+    std::vector<Slot> slots;
+    std::atomic<uint64_t> writeIndex{0};
+
+    std::array<float, FRAME_HISTORY> frames{};
+    size_t frameCount = 0;
+    uint64_t lastFrameNs = 0;
+
+    static uint32_t threadId();
+};
+
+// Records the enclosing scope as one event
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(name)
+        , start(Profiler::instance().now()) {}
+    ~ProfileScope() {
+        Profiler& profiler = Profiler::instance();
+        profiler.record(name, start, profiler.now() - start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#if MATCH3_PROFILING
+#define MATCH3_PROFILE_CONCAT_INNER(a, b) a##b
+#define MATCH3_PROFILE_CONCAT(a, b) MATCH3_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope MATCH3_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::instance().markFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
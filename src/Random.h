@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// SplitMix64 step: advances `state` and returns a well-mixed 64-bit value.
+// Used to expand one seed into generator state and to derive per-game seeds.
+constexpr uint64_t splitMix64(uint64_t& state) {
+    uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// xoshiro256** generator: 32 bytes of state, a handful of instructions per
+// 64-bit output. Not thread-safe; give each thread (or board) its own.
+// Satisfies UniformRandomBitGenerator, so it also works with <random>.
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seedValue = 0) { seed(seedValue); }
+
+    // Same seed, same sequence
+    void seed(uint64_t seedValue) {
+        for (auto& word : state) {
+            word = splitMix64(seedValue);
+        }
+    }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform value in [0, bound) without modulo bias (Lemire's method)
+    uint32_t below(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * bound;
+        if (static_cast<uint32_t>(product) < bound) {
+            const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (static_cast<uint32_t>(product) < threshold) {
+                product = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * bound;
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+};
@@ -1,9 +1,55 @@
 #include "Renderer.h"
 #include "MathUtils.h"
-#include <SDL3_image/SDL_image.h>
+#include "Profiler.h"
 #include <cmath>
 #include <cstdio>
 
+namespace {
+
+// The GemStonesV2 tile sheets hold the 16 numbered sprites in 8 columns and
+// 2 rows, in reverse order: sprite 16 is the top-left tile, sprite 01 the
+// bottom-right. One sheet ships per tile size.
+const int ATLAS_TILE_SIZES[] = {16, 32, 64, 128, 256, 512};
+const int ATLAS_COLUMNS = 8;
+const int ATLAS_ROWS = 2;
+const int ATLAS_SPRITES = ATLAS_COLUMNS * ATLAS_ROWS;
+
+// Images are few and large, so a couple of decode threads is enough
+const unsigned ASSET_LOADER_THREADS = 2;
+
+// Score bar along the top of the window
+const float SCORE_BAR_MARGIN = 10.0f;
+const float SCORE_BAR_HEIGHT = 60.0f;
+
+#if MATCH3_PROFILING
+// Frame-time graph along the bottom of the window
+const float FRAME_GRAPH_PIXELS_PER_MS = 4.0f;
+const float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+#endif
+
+// Smallest tile size that covers the on-screen sprite, so sprites are never
+// upscaled and small screens do not load large sheets
+int atlasTileSizeFor(int spritePixels) {
+    for (int size : ATLAS_TILE_SIZES) {
+        if (size >= spritePixels) return size;
+    }
+    return ATLAS_TILE_SIZES[sizeof(ATLAS_TILE_SIZES) / sizeof(ATLAS_TILE_SIZES[0]) - 1];
+}
+
+SDL_FRect atlasRegion(int spriteNumber) {
+    int tile = ATLAS_SPRITES - spriteNumber;
+    float width = 1.0f / ATLAS_COLUMNS;
+    float height = 1.0f / ATLAS_ROWS;
+    return SDL_FRect{(tile % ATLAS_COLUMNS) * width, (tile / ATLAS_COLUMNS) * height, width, height};
+}
+
+SDL_FColor toFColor(SDL_Color color, float alpha = 1.0f) {
+    return SDL_FColor{color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
+                      color.a / 255.0f * MathUtils::clamp(alpha, 0.0f, 1.0f)};
+}
+
+} // namespace
+
 Renderer::Renderer(SDL_Renderer* renderer, int windowWidth, int windowHeight)
     : renderer(renderer)
     , font(nullptr)
@@ -12,10 +58,23 @@ Renderer::Renderer(SDL_Renderer* renderer, int windowWidth, int windowHeight)
     , gemSize(0)
     , gridOffsetX(0)
     , gridOffsetY(0)
-    , gemTextures{}
+    , gemAtlas(nullptr)
+    , atlasTileSize(0)
+    , requestedTileSize(0)
+    , gemRegions{}
+    , textCache(renderer, SDL_Color{255, 255, 255, 255})
+    , assetLoader(renderer, ASSET_LOADER_THREADS)
+#if MATCH3_PROFILING
+    , showFrameGraph(false)
+#endif
 {
+    // Needed for faded gems when the fallback draws untextured quads
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    // The atlas arrives asynchronously; gems draw as colored quads until then
     calculateLayout();
-    loadGemTextures();
+    loadGemRegions();
+    updateGemAtlas();
 
     // Load font from bundled assets directory
     // The font file should be placed in assets/fonts/ relative to the executable
@@ -24,37 +83,54 @@ Renderer::Renderer(SDL_Renderer* renderer, int windowWidth, int windowHeight)
     if (!font) {
         SDL_Log("Warning: Could not load font from assets/fonts/DejaVuSans.ttf: %s", SDL_GetError());
     }
+    textCache.setFont(font);
 }
 
-void Renderer::loadGemTextures() {
-    // Map GemType to sprite file numbers based on colors:
-    // RED=06.png, GREEN=02.png, BLUE=01.png, YELLOW=03.png, PURPLE=08.png, ORANGE=04.png
-    const char* spriteFiles[] = {
-        "assets/sprites/GemStonesV2/64x64px/06.png",  // RED
-        "assets/sprites/GemStonesV2/64x64px/02.png",  // GREEN
-        "assets/sprites/GemStonesV2/64x64px/01.png",  // BLUE
-        "assets/sprites/GemStonesV2/64x64px/03.png",  // YELLOW
-        "assets/sprites/GemStonesV2/64x64px/08.png",  // PURPLE
-        "assets/sprites/GemStonesV2/64x64px/04.png",  // ORANGE
-    };
-
+void Renderer::loadGemRegions() {
+    // Map GemType to sprite numbers based on colors:
+    // RED=06, GREEN=02, BLUE=01, YELLOW=03, PURPLE=08, ORANGE=04
+    const int spriteNumbers[] = {6, 2, 1, 3, 8, 4};
     for (size_t i = 0; i < static_cast<size_t>(GemType::COUNT); ++i) {
-        gemTextures[i] = IMG_LoadTexture(renderer, spriteFiles[i]);
-        if (!gemTextures[i]) {
-            SDL_Log("Warning: Could not load gem texture %s: %s", spriteFiles[i], SDL_GetError());
-        }
+        gemRegions[i] = atlasRegion(spriteNumbers[i]);
     }
 }
 
-Renderer::~Renderer() {
-    // Clean up gem textures
-    for (auto& texture : gemTextures) {
-        if (texture) {
-            SDL_DestroyTexture(texture);
-            texture = nullptr;
+void Renderer::updateGemAtlas() {
+    // Every sheet shares the same layout, so the regions stay valid
+    int tileSize = atlasTileSizeFor(gemSize - 8);
+    if (tileSize == requestedTileSize) {
+        return;
+    }
+    requestedTileSize = tileSize;
+
+    char path[128];
+    snprintf(path, sizeof(path), "assets/sprites/GemStonesV2/TileSet%dx%dpx.png", tileSize, tileSize);
+    assetLoader.loadTexture(path, [this, tileSize](SDL_Texture* atlas) {
+        if (!atlas) {
+            // Keep drawing with the previous sheet, if any
+            return;
+        }
+        if (tileSize != requestedTileSize) {
+            // The layout changed again while this sheet was loading
+            SDL_DestroyTexture(atlas);
+            return;
+        }
+
+        if (gemAtlas) {
+            SDL_DestroyTexture(gemAtlas);
         }
+        gemAtlas = atlas;
+        atlasTileSize = tileSize;
+    });
+}
+
+Renderer::~Renderer() {
+    if (gemAtlas) {
+        SDL_DestroyTexture(gemAtlas);
+        gemAtlas = nullptr;
     }
 
+    textCache.setFont(nullptr);
     if (font) {
         TTF_CloseFont(font);
         font = nullptr;
@@ -65,6 +141,7 @@ void Renderer::setWindowSize(int width, int height) {
     windowWidth = width;
     windowHeight = height;
     calculateLayout();
+    updateGemAtlas();
 }
 
 void Renderer::calculateLayout() {
@@ -80,35 +157,103 @@ void Renderer::calculateLayout() {
     gridOffsetY = ((windowHeight - 100) - gridHeight) / 2 + 100; // Offset for score
 }
 
-void Renderer::render(const Grid& grid) {
+void Renderer::render(const Grid& grid, float blend) {
+    PROFILE_SCOPE("Renderer::render");
+
+    // Upload any images that finished decoding
+    {
+        PROFILE_SCOPE("AssetLoader::poll");
+        assetLoader.poll();
+    }
+
     // Clear screen
     SDL_SetRenderDrawColor(renderer, 30, 30, 40, 255);
     SDL_RenderClear(renderer);
 
-    drawBackground();
+    {
+        PROFILE_SCOPE("Renderer::drawBackground");
+        batchBackground();
+        backgroundBatch.draw(renderer, nullptr);
+    }
     drawScore(grid.getScore());
+    drawGems(grid, blend);
+
+#if MATCH3_PROFILING
+    if (showFrameGraph) {
+        drawFrameGraph();
+    }
+#endif
+}
 
-    // Draw gems
+void Renderer::drawGems(const Grid& grid, float blend) {
+    PROFILE_SCOPE("Renderer::drawGems");
+
+    gemBatch.clear();
     for (int row = 0; row < Grid::ROWS; ++row) {
         for (int col = 0; col < Grid::COLS; ++col) {
-            const Gem* gem = grid.getGem(row, col);
+            Gem gem = grid.getGem(row, col);
             if (gem) {
                 float alpha = 1.0f;
-                if (gem->getState() == GemState::EXPLODING) {
+                if (gem.getState() == GemState::EXPLODING) {
                     // Fade out during explosion
-                    alpha = 1.0f - (gem->getY() - gem->getRow());
+                    alpha = 1.0f - (gem.getY() - gem.getRow());
                     if (alpha < 0.0f) alpha = 0.0f;
                 }
-                drawGem(gem, alpha);
+                batchGem(gem, blend, alpha);
             }
         }
     }
+    // Without the atlas the gems are colored quads
+    gemBatch.draw(renderer, gemAtlas);
+}
 
+void Renderer::present() {
+    PROFILE_SCOPE("SDL_RenderPresent");
     SDL_RenderPresent(renderer);
 }
 
-void Renderer::drawBackground() {
-    // Draw grid cells
+#if MATCH3_PROFILING
+void Renderer::drawFrameGraph() {
+    overlayBatch.clear();
+
+    // One bar per frame, newest on the right; red bars missed 60 Hz
+    std::vector<float> frameTimes = Profiler::instance().frameTimes();
+    float barWidth = static_cast<float>(windowWidth) / Profiler::FRAME_HISTORY;
+    float baseline = static_cast<float>(windowHeight);
+    float x = windowWidth - barWidth * frameTimes.size();
+    for (float ms : frameTimes) {
+        float height = ms * FRAME_GRAPH_PIXELS_PER_MS;
+        SDL_FColor color = ms > FRAME_BUDGET_MS ? toFColor({220, 60, 60, 255}, 0.8f)
+                                                : toFColor({60, 200, 90, 255}, 0.8f);
+        overlayBatch.addRect(SDL_FRect{x, baseline - height, barWidth, height}, color);
+        x += barWidth;
+    }
+
+    // Budget line
+    float budgetY = baseline - FRAME_BUDGET_MS * FRAME_GRAPH_PIXELS_PER_MS;
+    overlayBatch.addRect(SDL_FRect{0.0f, budgetY, static_cast<float>(windowWidth), 1.0f},
+                         toFColor({255, 255, 255, 255}, 0.6f));
+
+    overlayBatch.draw(renderer, nullptr);
+}
+#endif
+
+void Renderer::batchBackground() {
+    backgroundBatch.clear();
+
+    // Score bar
+    SDL_FRect scoreBar{SCORE_BAR_MARGIN, SCORE_BAR_MARGIN,
+                       windowWidth - 2 * SCORE_BAR_MARGIN, SCORE_BAR_HEIGHT};
+    backgroundBatch.addRect(scoreBar, toFColor({60, 60, 70, 255}));
+
+    // Loading progress along the bottom edge of the score bar
+    if (assetLoader.isLoading()) {
+        SDL_FRect loadingBar{scoreBar.x, scoreBar.y + scoreBar.h - 4.0f,
+                             scoreBar.w * assetLoader.progress(), 4.0f};
+        backgroundBatch.addRect(loadingBar, toFColor({120, 120, 140, 255}));
+    }
+
+    // Grid cells
     for (int row = 0; row < Grid::ROWS; ++row) {
         for (int col = 0; col < Grid::COLS; ++col) {
             SDL_FRect rect;
@@ -116,87 +261,51 @@ void Renderer::drawBackground() {
             rect.y = static_cast<float>(gridOffsetY + row * gemSize + 2);
             rect.w = static_cast<float>(gemSize - 4);
             rect.h = static_cast<float>(gemSize - 4);
-
-            SDL_SetRenderDrawColor(renderer, 50, 50, 60, 255);
-            SDL_RenderFillRect(renderer, &rect);
+            backgroundBatch.addRect(rect, toFColor({50, 50, 60, 255}));
         }
     }
 }
 
-void Renderer::drawGem(const Gem* gem, float alpha) {
-    if (!gem) return;
-
-    GemType type = gem->getType();
+void Renderer::batchGem(const Gem& gem, float blend, float alpha) {
+    GemType type = gem.getType();
     if (type == GemType::EMPTY || type == GemType::COUNT) return;
 
     SDL_FRect rect;
-    rect.x = gridOffsetX + gem->getX() * gemSize + 4.0f;
-    rect.y = gridOffsetY + gem->getY() * gemSize + 4.0f;
+    rect.x = gridOffsetX + gem.getRenderX(blend) * gemSize + 4.0f;
+    rect.y = gridOffsetY + gem.getRenderY(blend) * gemSize + 4.0f;
     rect.w = static_cast<float>(gemSize - 8);
     rect.h = static_cast<float>(gemSize - 8);
 
-    SDL_Texture* texture = gemTextures[static_cast<size_t>(type)];
-    if (texture) {
-        // Draw sprite with alpha modulation
-        Uint8 adjustedAlpha = MathUtils::normalizedToByte(alpha);
-        SDL_SetTextureAlphaMod(texture, adjustedAlpha);
-        SDL_RenderTexture(renderer, texture, nullptr, &rect);
+    if (gemAtlas) {
+        // Sprite with per-vertex alpha
+        gemBatch.addQuad(rect, gemRegions[static_cast<size_t>(type)], toFColor({255, 255, 255, 255}, alpha));
     } else {
-        // Fallback to colored rectangle if texture failed to load
-        SDL_Color color = getGemColor(type);
-        Uint8 adjustedAlpha = MathUtils::normalizedToByte(alpha);
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, adjustedAlpha);
-        SDL_RenderFillRect(renderer, &rect);
+        // Fallback to colored rectangle if the atlas failed to load
+        gemBatch.addRect(rect, toFColor(getGemColor(type), alpha));
     }
 }
 
 void Renderer::drawScore(int score) {
-    // Draw score background bar
-    SDL_FRect scoreBar;
-    scoreBar.x = 10;
-    scoreBar.y = 10;
-    scoreBar.w = static_cast<float>(windowWidth - 20);
-    scoreBar.h = 60;
-
-    SDL_SetRenderDrawColor(renderer, 60, 60, 70, 255);
-    SDL_RenderFillRect(renderer, &scoreBar);
-
-    if (!font) {
-        return;
-    }
+    PROFILE_SCOPE("Renderer::drawScore");
 
-    // Format score text
+    // Format score text (the bar behind it is part of the background batch)
     char scoreText[64];
     snprintf(scoreText, sizeof(scoreText), "Score: %d", score);
 
-    // Render text to surface
-    SDL_Color textColor = {255, 255, 255, 255};
-    SDL_Surface* textSurface = TTF_RenderText_Blended(font, scoreText, 0, textColor);
-    if (!textSurface) {
+    // Only rasterized when the score changes
+    const TextCache::Text* text = textCache.get("score", scoreText);
+    if (!text) {
         return;
     }
 
-    // Create texture from surface
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    SDL_DestroySurface(textSurface);
-
-    if (!textTexture) {
-        return;
-    }
-
-    // Get texture dimensions
-    float textWidth, textHeight;
-    SDL_GetTextureSize(textTexture, &textWidth, &textHeight);
-
     // Position text centered vertically in the score bar, left-aligned with padding
     SDL_FRect textRect;
     textRect.x = 20;
-    textRect.y = scoreBar.y + (scoreBar.h - textHeight) / 2;
-    textRect.w = textWidth;
-    textRect.h = textHeight;
+    textRect.y = SCORE_BAR_MARGIN + (SCORE_BAR_HEIGHT - text->height) / 2;
+    textRect.w = text->width;
+    textRect.h = text->height;
 
-    SDL_RenderTexture(renderer, textTexture, nullptr, &textRect);
-    SDL_DestroyTexture(textTexture);
+    SDL_RenderTexture(renderer, text->texture, nullptr, &textRect);
 }
 
 SDL_Color Renderer::getGemColor(GemType type) const {
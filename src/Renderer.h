@@ -1,6 +1,9 @@
 #pragma once
 
+#include "AssetLoader.h"
 #include "Grid.h"
+#include "SpriteBatch.h"
+#include "TextCache.h"
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <array>
@@ -10,9 +13,18 @@ public:
     Renderer(SDL_Renderer* renderer, int windowWidth, int windowHeight);
     ~Renderer();
 
-    void render(const Grid& grid);
+    // blend places gems between the last two simulation steps (0 = previous,
+    // 1 = latest), so motion stays smooth when frames and steps differ
+    void render(const Grid& grid, float blend = 1.0f);
+    // Shows the frame; separate from render() so it can run without the
+    // simulation lock, since it may block on VSync
+    void present();
     void setWindowSize(int width, int height);
 
+#if MATCH3_PROFILING
+    void toggleFrameGraph() { showFrameGraph = !showFrameGraph; }
+#endif
+
     int getGemSize() const { return gemSize; }
     int getGridOffsetX() const { return gridOffsetX; }
     int getGridOffsetY() const { return gridOffsetY; }
@@ -26,13 +38,36 @@ private:
     int gridOffsetX;
     int gridOffsetY;
 
-    // Gem sprite textures indexed by GemType
-    std::array<SDL_Texture*, static_cast<size_t>(GemType::COUNT)> gemTextures;
+    // All gem sprites come from one tile sheet, so every gem is drawn in a
+    // single batch. The sheet is the smallest shipped size that covers the
+    // on-screen gem and is swapped when the layout changes. gemRegions holds
+    // each GemType's tile in normalized texture coordinates.
+    SDL_Texture* gemAtlas;
+    int atlasTileSize;      // Pixels per tile in gemAtlas
+    int requestedTileSize;  // Sheet last asked of the loader
+    std::array<SDL_FRect, static_cast<size_t>(GemType::COUNT)> gemRegions;
+
+    // HUD strings, re-rendered only when they change
+    TextCache textCache;
+
+    AssetLoader assetLoader;
+
+    // Rebuilt every frame: score bar and cells, then gems
+    SpriteBatch backgroundBatch;
+    SpriteBatch gemBatch;
+
+#if MATCH3_PROFILING
+    bool showFrameGraph;
+    SpriteBatch overlayBatch;
+    void drawFrameGraph();
+#endif
 
     void calculateLayout();
-    void loadGemTextures();
-    void drawGem(const Gem* gem, float alpha = 1.0f);
-    void drawBackground();
+    void loadGemRegions();
+    void updateGemAtlas();
+    void batchGem(const Gem& gem, float blend, float alpha = 1.0f);
+    void batchBackground();
+    void drawGems(const Grid& grid, float blend);
     void drawScore(int score);
     SDL_Color getGemColor(GemType type) const;
 };
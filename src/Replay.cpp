@@ -0,0 +1,239 @@
+#include "Replay.h"
+#include "GemGenerators.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const char MAGIC[4] = {'M', '3', 'R', 'P'};
+const size_t HEADER_SIZE = 28;
+
+// The swap byte holds a cell index in seven bits
+static_assert(BoardState::CELLS <= 128, "Cell indices must fit in seven bits");
+
+class Writer {
+public:
+    explicit Writer(std::vector<uint8_t>& out) : out(out) {}
+
+    void u8(uint8_t value) { out.push_back(value); }
+    void u16(uint16_t value) { little(value, 2); }
+    void u32(uint32_t value) { little(value, 4); }
+    void u64(uint64_t value) { little(value, 8); }
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+private:
+    std::vector<uint8_t>& out;
+
+    void little(uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+};
+
+// Every read fails once the data runs out
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    bool u8(uint8_t& value) {
+        uint64_t wide;
+        if (!little(wide, 1)) return false;
+        value = static_cast<uint8_t>(wide);
+        return true;
+    }
+    bool u16(uint16_t& value) {
+        uint64_t wide;
+        if (!little(wide, 2)) return false;
+        value = static_cast<uint16_t>(wide);
+        return true;
+    }
+    bool u32(uint32_t& value) {
+        uint64_t wide;
+        if (!little(wide, 4)) return false;
+        value = static_cast<uint32_t>(wide);
+        return true;
+    }
+    bool u64(uint64_t& value) { return little(value, 8); }
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (offset == size) return false;
+            uint8_t byte = data[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;  // Longer than any 64-bit value
+    }
+
+    size_t remaining() const { return size - offset; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+
+    bool little(uint64_t& value, int bytes) {
+        if (remaining() < static_cast<size_t>(bytes)) return false;
+        value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<uint64_t>(data[offset++]) << (8 * i);
+        }
+        return true;
+    }
+};
+
+uint8_t encodeMove(const Move& move) {
+    // Swaps are symmetric; store the top/left cell and a direction
+    Position first = move.to < move.from ? move.to : move.from;
+    bool vertical = move.from.col == move.to.col;
+    int cell = first.row * BoardState::COLS + first.col;
+    return static_cast<uint8_t>((cell << 1) | (vertical ? 1 : 0));
+}
+
+bool decodeMove(uint8_t byte, Move& move) {
+    int cell = byte >> 1;
+    bool vertical = byte & 1;
+    if (cell >= BoardState::CELLS) return false;
+
+    Position first(cell / BoardState::COLS, cell % BoardState::COLS);
+    Position second = vertical ? Position(first.row + 1, first.col) : Position(first.row, first.col + 1);
+    if (second.row >= BoardState::ROWS || second.col >= BoardState::COLS) return false;
+
+    move = Move{first, second};
+    return true;
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeReplay(const Replay& replay) {
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + 2 * replay.swaps.size());
+    Writer writer(out);
+
+    for (char c : MAGIC) {
+        writer.u8(static_cast<uint8_t>(c));
+    }
+    writer.u16(REPLAY_VERSION);
+    writer.u8(BoardState::ROWS);
+    writer.u8(BoardState::COLS);
+    writer.u8(BoardState::COLORS);
+    writer.u8(0);
+    writer.u16(static_cast<uint16_t>(replay.stepRate));
+    writer.u64(replay.seed);
+    writer.u32(static_cast<uint32_t>(replay.finalScore));
+    writer.u32(static_cast<uint32_t>(replay.swaps.size()));
+
+    uint64_t previousStep = 0;
+    for (const ReplaySwap& swap : replay.swaps) {
+        writer.varint(swap.step - previousStep);
+        writer.u8(encodeMove(swap.move));
+        previousStep = swap.step;
+    }
+    return out;
+}
+
+std::optional<Replay> decodeReplay(const uint8_t* data, size_t size) {
+    if (size < HEADER_SIZE || !std::equal(std::begin(MAGIC), std::end(MAGIC), data)) {
+        return std::nullopt;
+    }
+    // The header is complete, so its reads cannot fail
+    Reader reader(data + sizeof(MAGIC), size - sizeof(MAGIC));
+
+    uint16_t version, stepRate;
+    uint8_t rows, cols, colors, reserved;
+    uint32_t finalScore, swapCount;
+    Replay replay;
+    reader.u16(version);
+    reader.u8(rows);
+    reader.u8(cols);
+    reader.u8(colors);
+    reader.u8(reserved);
+    reader.u16(stepRate);
+    reader.u64(replay.seed);
+    reader.u32(finalScore);
+    reader.u32(swapCount);
+
+    if (version != REPLAY_VERSION || rows != BoardState::ROWS || cols != BoardState::COLS ||
+        colors != BoardState::COLORS || stepRate == 0) {
+        return std::nullopt;
+    }
+    // Each swap takes at least two bytes; checked before reserving
+    if (swapCount > reader.remaining() / 2) {
+        return std::nullopt;
+    }
+    replay.stepRate = stepRate;
+    replay.finalScore = static_cast<int32_t>(finalScore);
+
+    replay.swaps.reserve(swapCount);
+    uint64_t step = 0;
+    for (uint32_t i = 0; i < swapCount; ++i) {
+        uint64_t delta;
+        uint8_t byte;
+        ReplaySwap swap;
+        if (!reader.varint(delta) || !reader.u8(byte) || !decodeMove(byte, swap.move)) {
+            return std::nullopt;
+        }
+        step += delta;
+        swap.step = step;
+        replay.swaps.push_back(swap);
+    }
+
+    if (reader.remaining() != 0) {
+        return std::nullopt;
+    }
+    return replay;
+}
+
+bool saveReplay(const Replay& replay, const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> data = encodeReplay(replay);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+std::optional<Replay> loadReplay(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decodeReplay(data.data(), data.size());
+}
+
+ReplayResult playReplay(const Replay& replay) {
+    BoardLogic logic(replay.seed);
+    BoardState state;
+    logic.initializeBoard(state);
+
+    ReplayResult result;
+    BoardLogic::SequenceResult sequence;
+    ConstantGems noRefills{GemType::EMPTY};
+    for (const ReplaySwap& swap : replay.swaps) {
+        logic.executeSequence(state, swap.move, noRefills, sequence);
+        if (!sequence.swapValid) {
+            if (!logic.isValidSwap(state, swap.move)) {
+                continue;  // The game would have refused it too
+            }
+            // The game keeps swaps that make no match
+            logic.executeSwap(state, swap.move);
+        }
+        ++result.swapsApplied;
+    }
+
+    result.score = state.score;
+    result.outOfMoves = !logic.hasValidMoves(state);
+    return result;
+}
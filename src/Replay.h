@@ -0,0 +1,63 @@
+#pragma once
+
+#include "BoardLogic.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// A recorded game: the seed of the board's gem generator and every swap the
+// game applied, stamped with the simulation step it was applied in. The
+// simulation runs in fixed steps, so replaying the swaps at the same steps
+// reproduces the game exactly, animations included.
+//
+// File format, little-endian:
+//
+//   "M3RP"          magic
+//   u16 version     REPLAY_VERSION
+//   u8 rows, u8 cols, u8 colors, u8 reserved (0)
+//   u16 stepRate    simulation steps per second
+//   u64 seed
+//   i32 finalScore  score when recording stopped
+//   u32 swapCount
+//   swapCount x {
+//     varint        steps since the previous swap (since step 0 for the first)
+//     u8            (top/left cell index << 1) | 1 if the swap is vertical
+//   }
+//
+// A typical swap takes two bytes.
+struct ReplaySwap {
+    uint64_t step = 0;
+    Move move{};
+
+    bool operator==(const ReplaySwap& other) const {
+        return step == other.step && move == other.move;
+    }
+};
+
+struct Replay {
+    uint64_t seed = 0;
+    int stepRate = 120;
+    int finalScore = 0;
+    std::vector<ReplaySwap> swaps;
+};
+
+constexpr uint16_t REPLAY_VERSION = 1;
+
+std::vector<uint8_t> encodeReplay(const Replay& replay);
+// nullopt for data that is not a valid replay of the standard board
+std::optional<Replay> decodeReplay(const uint8_t* data, size_t size);
+
+bool saveReplay(const Replay& replay, const std::string& path);
+std::optional<Replay> loadReplay(const std::string& path);
+
+struct ReplayResult {
+    int score = 0;
+    int swapsApplied = 0;
+    bool outOfMoves = false;  // No valid move left after the last swap
+};
+
+// Play a replay headlessly at full speed through BoardLogic::executeSequence,
+// following the game's rules: the board is dealt from the replay's seed,
+// emptied cells are not refilled, and a swap that makes no match stays.
+ReplayResult playReplay(const Replay& replay);
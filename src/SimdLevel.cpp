@@ -0,0 +1,120 @@
+#include "SimdLevel.h"
+#include "BoardKernels.h"
+#include <atomic>
+#include <cstdlib>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+#if MATCH3_SSE2_LANES
+constexpr bool SSE2_LANES = true;
+#else
+constexpr bool SSE2_LANES = false;
+#endif
+#if MATCH3_NEON_LANES
+constexpr bool NEON_LANES = true;
+#else
+constexpr bool NEON_LANES = false;
+#endif
+
+bool cpuHasAvx2() {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    // Also checks that the OS saves the AVX registers
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+                            (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesAvx && (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+SimdLevel initialLevel() {
+    // MATCH3_SIMD=scalar and the like, to test or time one path
+    if (const char* name = std::getenv("MATCH3_SIMD")) {
+        std::optional<SimdLevel> level = parseSimdLevel(name);
+        if (level && simdLevelSupported(*level)) {
+            return *level;
+        }
+    }
+    return bestSimdLevel();
+}
+
+// Holds a SimdLevel, or -1 until the first read
+std::atomic<int> currentLevel{-1};
+
+} // namespace
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR: return "scalar";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::NEON: return "neon";
+    }
+    return "unknown";
+}
+
+std::optional<SimdLevel> parseSimdLevel(const std::string& name) {
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+        if (name == simdLevelName(level)) {
+            return level;
+        }
+    }
+    return std::nullopt;
+}
+
+bool simdLevelSupported(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return true;
+        case SimdLevel::SSE2:
+            return SSE2_LANES;
+        case SimdLevel::AVX2: {
+            static const bool supported = BoardKernels::avx2Built() && cpuHasAvx2();
+            return supported;
+        }
+        case SimdLevel::NEON:
+            return NEON_LANES;
+    }
+    return false;
+}
+
+SimdLevel bestSimdLevel() {
+    for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::NEON, SimdLevel::SSE2}) {
+        if (simdLevelSupported(level)) {
+            return level;
+        }
+    }
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel simdLevel() {
+    int level = currentLevel.load(std::memory_order_relaxed);
+    if (level < 0) {
+        int unset = -1;
+        currentLevel.compare_exchange_strong(unset, static_cast<int>(initialLevel()), std::memory_order_relaxed);
+        level = currentLevel.load(std::memory_order_relaxed);
+    }
+    return static_cast<SimdLevel>(level);
+}
+
+bool setSimdLevel(SimdLevel level) {
+    if (!simdLevelSupported(level)) {
+        return false;
+    }
+    currentLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    return true;
+}
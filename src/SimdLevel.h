@@ -0,0 +1,33 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+// Vector instruction sets the board rules can run on. BoardLogic keeps each
+// color of a board in a 64-bit bitboard; with a vector level, several
+// colors' bitboards sit side by side in one register and are matched and
+// scanned for swaps together. SCALAR runs the plain bitboard loops and is
+// the reference the vector paths are tested against.
+enum class SimdLevel {
+    SCALAR,
+    SSE2,  // Two colors per register, any x86-64 CPU
+    AVX2,  // Four colors per register, chosen at runtime
+    NEON   // Two colors per register, any ARM CPU with NEON
+};
+
+const char* simdLevelName(SimdLevel level);
+std::optional<SimdLevel> parseSimdLevel(const std::string& name);
+
+// Whether this build and this CPU can run the level
+bool simdLevelSupported(SimdLevel level);
+
+// Fastest supported level, detected once
+SimdLevel bestSimdLevel();
+
+// Level every BoardLogic uses. Starts at bestSimdLevel(), or at the level
+// named by the MATCH3_SIMD environment variable when it is supported.
+SimdLevel simdLevel();
+
+// Switches every BoardLogic to the level, for tests and benchmarks. False,
+// with nothing changed, if the level is not supported.
+bool setSimdLevel(SimdLevel level);
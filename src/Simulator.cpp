@@ -0,0 +1,201 @@
+#include "Simulator.h"
+#include "ThreadPool.h"
+#include "GemGenerators.h"
+#include "MoveSearcher.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::optional<MovePolicy> parseMovePolicy(const std::string& name) {
+    if (name == "random") return MovePolicy::RANDOM;
+    if (name == "greedy") return MovePolicy::GREEDY;
+    if (name == "first") return MovePolicy::FIRST_VALID;
+    if (name == "search") return MovePolicy::SEARCH;
+    return std::nullopt;
+}
+
+const char* movePolicyName(MovePolicy policy) {
+    switch (policy) {
+        case MovePolicy::RANDOM:      return "random";
+        case MovePolicy::GREEDY:      return "greedy";
+        case MovePolicy::FIRST_VALID: return "first";
+        case MovePolicy::SEARCH:      return "search";
+    }
+    return "unknown";
+}
+
+void SimulationStats::addGame(int score, int moves, bool outOfMoves) {
+    shortestGame = games == 0 ? moves : std::min(shortestGame, moves);
+    longestGame = std::max(longestGame, moves);
+    ++games;
+    totalScore += static_cast<uint64_t>(score);
+    totalMoves += static_cast<uint64_t>(moves);
+    if (outOfMoves) ++gamesOutOfMoves;
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    if (other.games == 0) return;
+    shortestGame = games == 0 ? other.shortestGame : std::min(shortestGame, other.shortestGame);
+    longestGame = std::max(longestGame, other.longestGame);
+    games += other.games;
+    totalScore += other.totalScore;
+    totalMoves += other.totalMoves;
+    gamesOutOfMoves += other.gamesOutOfMoves;
+    for (size_t i = 0; i < cascadeDepths.size(); ++i) {
+        cascadeDepths[i] += other.cascadeDepths[i];
+    }
+}
+
+double SimulationStats::averageScore() const {
+    return games ? static_cast<double>(totalScore) / games : 0.0;
+}
+
+double SimulationStats::averageMoves() const {
+    return games ? static_cast<double>(totalMoves) / games : 0.0;
+}
+
+double SimulationStats::gamesPerSecond() const {
+    return elapsedSeconds > 0.0 ? games / elapsedSeconds : 0.0;
+}
+
+namespace {
+
+// Games handed to the pool per task
+const uint64_t GAMES_PER_TASK = 64;
+
+// Independent seed for one game, from the base seed and the game index
+uint64_t gameSeed(uint64_t seed, uint64_t gameIndex) {
+    uint64_t mixed = seed ^ splitMix64(gameIndex);
+    return splitMix64(mixed);
+}
+
+template <typename Logic>
+class GameRunner {
+public:
+    using State = typename Logic::State;
+
+    explicit GameRunner(const SimulationConfig& config)
+        : config(config)
+        , logic(config.seed)
+    {
+        if (config.policy == MovePolicy::SEARCH) {
+            // One searcher per runner; the runners already use every core
+            SearchConfig search;
+            search.maxDepth = 2;
+            search.chanceSamples = 2;
+            search.timeBudgetMs = 0.0;
+            search.threads = 1;
+            search.seed = config.seed;
+            searcher = std::make_unique<BasicMoveSearcher<Logic>>(search);
+        }
+    }
+
+    void play(uint64_t gameIndex, SimulationStats& stats) {
+        // Board refills and move choices use separate streams of the game seed
+        uint64_t seed = gameSeed(config.seed, gameIndex);
+        logic.seed(seed);
+        rng.seed(~seed);
+
+        State state;
+        logic.initializeBoard(state);
+
+        int moveCount = 0;
+        bool outOfMoves = false;
+        while (moveCount < config.maxMoves) {
+            logic.enumerateValidMoves(state, moves);
+            if (moves.empty()) {
+                outOfMoves = true;
+                break;
+            }
+
+            logic.executeSequence(state, chooseMove(state), sequence);
+            size_t depth = std::min(sequence.matches.size(), stats.cascadeDepths.size() - 1);
+            ++stats.cascadeDepths[depth];
+            ++moveCount;
+        }
+
+        stats.addGame(state.score, moveCount, outOfMoves);
+    }
+
+private:
+    const SimulationConfig& config;
+    Xoshiro256 rng;
+    Logic logic;
+    std::vector<Move> moves;
+    typename Logic::SequenceResult sequence;  // Reused so cascades don't allocate
+    std::unique_ptr<BasicMoveSearcher<Logic>> searcher;
+    Move searched{};
+
+    const Move& chooseMove(const State& state) {
+        switch (config.policy) {
+            case MovePolicy::FIRST_VALID:
+                return moves.front();
+
+            case MovePolicy::RANDOM: {
+                return moves[rng.below(static_cast<uint32_t>(moves.size()))];
+            }
+
+            case MovePolicy::GREEDY: {
+                // Score each move with refills left empty, so only the
+                // cascades already visible on the board count
+                size_t best = 0;
+                int bestScore = -1;
+                for (size_t i = 0; i < moves.size(); ++i) {
+                    State trial = state;
+                    logic.executeSequence(trial, moves[i], ConstantGems{GemType::EMPTY}, sequence);
+                    int score = sequence.totalScore;
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = i;
+                    }
+                }
+                return moves[best];
+            }
+
+            case MovePolicy::SEARCH:
+                searched = searcher->search(state).bestMove;
+                return searched;
+        }
+        return moves.front();
+    }
+};
+
+template <typename Logic>
+SimulationStats simulate(const SimulationConfig& config) {
+    SimulationStats total;
+    std::mutex totalMutex;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(config.threads);
+        for (uint64_t first = 0; first < config.games; first += GAMES_PER_TASK) {
+            uint64_t last = std::min(config.games, first + GAMES_PER_TASK);
+            pool.submit([&config, &total, &totalMutex, first, last] {
+                GameRunner<Logic> runner(config);
+                SimulationStats stats;
+                for (uint64_t game = first; game < last; ++game) {
+                    runner.play(game, stats);
+                }
+                std::lock_guard<std::mutex> lock(totalMutex);
+                total.merge(stats);
+            });
+        }
+        pool.wait();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    total.elapsedSeconds = std::chrono::duration<double>(elapsed).count();
+    return total;
+}
+
+} // namespace
+
+std::optional<SimulationStats> runSimulation(const SimulationConfig& config) {
+    std::optional<SimulationStats> stats;
+    visitBoardShape(config.level, [&](auto shape) {
+        stats = simulate<typename decltype(shape)::Logic>(config);
+    });
+    return stats;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "LevelConfig.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// How a simulated player picks its next swap
+enum class MovePolicy {
+    RANDOM,       // Any valid move, uniformly
+    GREEDY,       // The move scoring most before refills are known
+    FIRST_VALID,  // The first valid move in row-major order
+    SEARCH        // MoveSearcher's best move, two moves deep
+};
+
+std::optional<MovePolicy> parseMovePolicy(const std::string& name);
+const char* movePolicyName(MovePolicy policy);
+
+struct SimulationConfig {
+    LevelConfig level;
+    MovePolicy policy = MovePolicy::RANDOM;
+    uint64_t games = 1000;
+    unsigned threads = 0;   // 0 = one per hardware core
+    uint64_t seed = 1;      // Game i is seeded from (seed, i), independent of threads
+    int maxMoves = 500;     // Games still going after this many moves are cut off
+};
+
+struct SimulationStats {
+    // Cascade depth = match rounds triggered by one move; the last bucket
+    // also collects deeper cascades
+    static const int MAX_CASCADE_DEPTH = 16;
+
+    uint64_t games = 0;
+    uint64_t totalScore = 0;
+    uint64_t totalMoves = 0;
+    uint64_t gamesOutOfMoves = 0;  // Ended because no valid move was left
+    int shortestGame = 0;          // Moves
+    int longestGame = 0;
+    std::array<uint64_t, MAX_CASCADE_DEPTH + 1> cascadeDepths{};
+    double elapsedSeconds = 0.0;
+
+    void addGame(int score, int moves, bool outOfMoves);
+    void merge(const SimulationStats& other);
+
+    double averageScore() const;
+    double averageMoves() const;
+    double gamesPerSecond() const;
+};
+
+// Play config.games complete games on a thread pool. Returns nullopt when
+// the level's board shape has no compiled rules.
+std::optional<SimulationStats> runSimulation(const SimulationConfig& config);
@@ -0,0 +1,34 @@
+#include "SpriteBatch.h"
+
+void SpriteBatch::clear() {
+    vertices.clear();
+    indices.clear();
+}
+
+void SpriteBatch::addQuad(const SDL_FRect& dst, const SDL_FRect& uv, SDL_FColor color) {
+    int first = static_cast<int>(vertices.size());
+
+    // Corners clockwise from top-left
+    vertices.push_back({{dst.x, dst.y}, color, {uv.x, uv.y}});
+    vertices.push_back({{dst.x + dst.w, dst.y}, color, {uv.x + uv.w, uv.y}});
+    vertices.push_back({{dst.x + dst.w, dst.y + dst.h}, color, {uv.x + uv.w, uv.y + uv.h}});
+    vertices.push_back({{dst.x, dst.y + dst.h}, color, {uv.x, uv.y + uv.h}});
+
+    const int corners[] = {0, 1, 2, 0, 2, 3};
+    for (int corner : corners) {
+        indices.push_back(first + corner);
+    }
+}
+
+void SpriteBatch::addRect(const SDL_FRect& dst, SDL_FColor color) {
+    addQuad(dst, SDL_FRect{0.0f, 0.0f, 0.0f, 0.0f}, color);
+}
+
+bool SpriteBatch::draw(SDL_Renderer* renderer, SDL_Texture* texture) const {
+    if (vertices.empty()) {
+        return true;
+    }
+    return SDL_RenderGeometry(renderer, texture,
+                              vertices.data(), static_cast<int>(vertices.size()),
+                              indices.data(), static_cast<int>(indices.size()));
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Collects quads into one vertex/index buffer and submits them with a single
+// SDL_RenderGeometry call. Color (including alpha) is per vertex, so quads
+// sharing a texture can fade independently without SDL_SetTextureAlphaMod.
+// The buffers keep their capacity across clear(), so steady-state frames do
+// not allocate.
+class SpriteBatch {
+public:
+    void clear();
+
+    // uv is a rectangle in normalized texture coordinates
+    void addQuad(const SDL_FRect& dst, const SDL_FRect& uv, SDL_FColor color);
+    // Solid quad for untextured batches
+    void addRect(const SDL_FRect& dst, SDL_FColor color);
+
+    // Draws every quad against texture (nullptr for solid colors). Does
+    // nothing when the batch is empty.
+    bool draw(SDL_Renderer* renderer, SDL_Texture* texture) const;
+
+    size_t quadCount() const { return vertices.size() / 4; }
+
+private:
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
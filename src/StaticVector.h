@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+
+// Vector with its storage inline and a fixed capacity, for lists whose size
+// is bounded by the board (matched cells, falling gems). Never allocates;
+// pushing past Capacity is a bug and asserts. Elements past size() are left
+// uninitialized, so T should be a small trivial type.
+template <typename T, size_t Capacity>
+class StaticVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    StaticVector() = default;
+    StaticVector(std::initializer_list<T> init) {
+        for (const T& item : init) push_back(item);
+    }
+
+    // Copies only the used elements
+    StaticVector(const StaticVector& other) { *this = other; }
+    StaticVector& operator=(const StaticVector& other) {
+        count = other.count;
+        for (size_t i = 0; i < count; ++i) items[i] = other.items[i];
+        return *this;
+    }
+
+    void push_back(const T& item) {
+        assert(count < Capacity);
+        items[count++] = item;
+    }
+    void pop_back() {
+        assert(count > 0);
+        --count;
+    }
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    T& front() { return items[0]; }
+    const T& front() const { return items[0]; }
+    T& back() { return items[count - 1]; }
+    const T& back() const { return items[count - 1]; }
+
+    T* data() { return items; }
+    const T* data() const { return items; }
+    iterator begin() { return items; }
+    iterator end() { return items + count; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + count; }
+
+    bool operator==(const StaticVector& other) const {
+        if (count != other.count) return false;
+        for (size_t i = 0; i < count; ++i) {
+            if (!(items[i] == other.items[i])) return false;
+        }
+        return true;
+    }
+    bool operator!=(const StaticVector& other) const { return !(*this == other); }
+
+private:
+    T items[Capacity];  // Only the first `count` are initialized
+    size_t count = 0;
+};
@@ -0,0 +1,57 @@
+#include "TextCache.h"
+
+TextCache::TextCache(SDL_Renderer* renderer, SDL_Color color)
+    : renderer(renderer)
+    , color(color) {
+}
+
+TextCache::~TextCache() {
+    clear();
+}
+
+void TextCache::setFont(TTF_Font* newFont) {
+    clear();
+    font = newFont;
+}
+
+const TextCache::Text* TextCache::get(std::string_view label, std::string_view text) {
+    if (!font) {
+        return nullptr;
+    }
+
+    auto it = entries.find(label);
+    if (it == entries.end()) {
+        it = entries.emplace(std::string(label), Entry()).first;
+    } else if (it->second.rendered.texture && it->second.text == text) {
+        return &it->second.rendered;
+    }
+
+    Entry& entry = it->second;
+    if (entry.rendered.texture) {
+        SDL_DestroyTexture(entry.rendered.texture);
+        entry.rendered = Text();
+    }
+    entry.text.assign(text.data(), text.size());
+
+    SDL_Surface* surface = TTF_RenderText_Blended(font, entry.text.c_str(), entry.text.size(), color);
+    if (!surface) {
+        return nullptr;
+    }
+    entry.rendered.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    if (!entry.rendered.texture) {
+        return nullptr;
+    }
+
+    SDL_GetTextureSize(entry.rendered.texture, &entry.rendered.width, &entry.rendered.height);
+    return &entry.rendered;
+}
+
+void TextCache::clear() {
+    for (auto& item : entries) {
+        if (item.second.rendered.texture) {
+            SDL_DestroyTexture(item.second.rendered.texture);
+        }
+    }
+    entries.clear();
+}
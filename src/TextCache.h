@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+// Rendered UI strings, one texture per label ("score", "moves", ...). A
+// label is only rasterized again when its text changes, so a HUD that is
+// redrawn every frame costs a string compare per label on frames where
+// nothing changed.
+class TextCache {
+public:
+    struct Text {
+        SDL_Texture* texture = nullptr;
+        float width = 0.0f;
+        float height = 0.0f;
+    };
+
+    TextCache(SDL_Renderer* renderer, SDL_Color color);
+    ~TextCache();
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    // Drops every cached texture; the font is not owned
+    void setFont(TTF_Font* newFont);
+
+    // Texture for the label showing text, rendered on first use and after
+    // the text changes. Returns nullptr without a font or on SDL failure.
+    const Text* get(std::string_view label, std::string_view text);
+
+    void clear();
+
+private:
+    struct Entry {
+        std::string text;
+        Text rendered;
+    };
+
+    SDL_Renderer* renderer;
+    TTF_Font* font = nullptr;
+    SDL_Color color;
+    std::map<std::string, Entry, std::less<>> entries;  // Transparent lookup by string_view
+};
@@ -0,0 +1,116 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+// Pool and worker index of the current thread, if it is a pool worker
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local unsigned currentWorker = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    unsigned index = (currentPool == this)
+        ? currentWorker
+        : nextWorker.fetch_add(1, std::memory_order_relaxed) % size();
+
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        ++queuedTasks;
+        ++unfinishedTasks;
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return unfinishedTasks == 0; });
+}
+
+bool ThreadPool::takeTask(unsigned index, std::function<void()>& task) {
+    // Own deque first, newest task (best cache locality)
+    {
+        Worker& own = *workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest task from the next worker that has one
+    for (unsigned offset = 1; offset < size(); ++offset) {
+        Worker& victim = *workers[(index + offset) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            taskAvailable.wait(lock, [this] { return queuedTasks > 0 || stopping; });
+            if (queuedTasks == 0 && stopping) {
+                return;
+            }
+            // Claim one queued task; it is already in some deque
+            --queuedTasks;
+        }
+
+        std::function<void()> task;
+        while (!takeTask(index, task)) {
+            std::this_thread::yield();
+        }
+
+        task();
+
+        bool finished;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            finished = --unfinishedTasks == 0;
+        }
+        if (finished) {
+            allDone.notify_all();
+        }
+    }
+}
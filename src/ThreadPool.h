@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Each worker owns a task deque: it pops its own
+// newest task first and, when empty, steals the oldest task from another
+// worker. Tasks submitted from inside a worker go to that worker's deque,
+// so recursive work stays local until someone else runs dry.
+class ThreadPool {
+public:
+    // threadCount 0 uses one thread per hardware core
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Block until every submitted task, including ones submitted by other
+    // tasks, has finished
+    void wait();
+
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    size_t queuedTasks = 0;      // In some deque, not yet picked up
+    size_t unfinishedTasks = 0;  // Submitted and not yet finished
+    bool stopping = false;
+
+    std::atomic<unsigned> nextWorker{0};
+
+    void workerLoop(unsigned index);
+    bool takeTask(unsigned index, std::function<void()>& task);
+};
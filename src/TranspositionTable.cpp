@@ -0,0 +1,87 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+
+namespace {
+
+// Packed entry layout, low bit first:
+//   score 32 | depth 7 | occupied 1 | valid moves 8 | from 8 | to 8
+// A cell packs as row << 4 | col; NO_MOVE in `from` means no best move.
+const uint64_t OCCUPIED = 1ull << 39;
+const uint64_t NO_MOVE = 0xFF;
+const int MAX_DEPTH = 127;
+
+uint64_t packCell(const Position& pos) {
+    return static_cast<uint64_t>((pos.row << 4) | pos.col);
+}
+
+Position unpackCell(uint64_t bits) {
+    return {static_cast<int>((bits >> 4) & 0xF), static_cast<int>(bits & 0xF)};
+}
+
+} // namespace
+
+TranspositionTable::TranspositionTable(size_t entries) {
+    size_t capacity = 1;
+    while (capacity * 2 <= entries) {
+        capacity *= 2;
+    }
+    slots = std::make_unique<Slot[]>(capacity);
+    mask = capacity - 1;
+}
+
+std::optional<TranspositionTable::Entry> TranspositionTable::probe(uint64_t key) const {
+    const Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if (!(data & OCCUPIED) || (check ^ data) != key) {
+        return std::nullopt;
+    }
+    return unpack(data);
+}
+
+void TranspositionTable::store(uint64_t key, const Entry& entry) {
+    Slot& slot = slots[key & mask];
+    uint64_t old = slot.data.load(std::memory_order_relaxed);
+    if ((old & OCCUPIED) && (slot.check.load(std::memory_order_relaxed) ^ old) == key &&
+        unpack(old).depth > entry.depth) {
+        return;
+    }
+
+    uint64_t data = pack(entry);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        slots[i].check.store(0, std::memory_order_relaxed);
+        slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t TranspositionTable::pack(const Entry& entry) {
+    uint64_t data = static_cast<uint32_t>(entry.score);
+    data |= static_cast<uint64_t>(std::min<int>(entry.depth, MAX_DEPTH)) << 32;
+    data |= OCCUPIED;
+    data |= static_cast<uint64_t>(entry.validMoves) << 40;
+    if (entry.hasBestMove) {
+        data |= packCell(entry.bestMove.from) << 48;
+        data |= packCell(entry.bestMove.to) << 56;
+    } else {
+        data |= NO_MOVE << 48;
+    }
+    return data;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) {
+    Entry entry;
+    entry.score = static_cast<int32_t>(static_cast<uint32_t>(data));
+    entry.depth = static_cast<uint8_t>((data >> 32) & MAX_DEPTH);
+    entry.validMoves = static_cast<uint8_t>(data >> 40);
+    uint64_t from = (data >> 48) & 0xFF;
+    entry.hasBestMove = from != NO_MOVE;
+    if (entry.hasBestMove) {
+        entry.bestMove = {unpackCell(from), unpackCell(data >> 56)};
+    }
+    return entry;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "BoardTypes.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// Fixed-size cache of per-position analysis, keyed by BoardState::hash().
+// Any number of threads may probe and store at once without locks: each
+// slot keeps its packed entry next to (key XOR entry), so a slot torn by
+// two concurrent writers fails the key check and reads as a miss.
+class TranspositionTable {
+public:
+    struct Entry {
+        int32_t score = 0;      // Evaluated score of the position
+        uint8_t depth = 0;      // Search depth the score was computed at, below 128
+        uint8_t validMoves = 0; // Number of valid moves, saturating at 255
+        bool hasBestMove = false;
+        Move bestMove{};        // Rows and columns below 15
+    };
+
+    // Capacity is `entries` rounded down to a power of two (at least 1)
+    explicit TranspositionTable(size_t entries);
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    std::optional<Entry> probe(uint64_t key) const;
+
+    // Replaces whatever shares the slot, unless it is the same position
+    // already searched deeper
+    void store(uint64_t key, const Entry& entry);
+
+    // Not safe to call while other threads use the table
+    void clear();
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check{0};  // key ^ data
+        std::atomic<uint64_t> data{0};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+
+    static uint64_t pack(const Entry& entry);
+    static Entry unpack(uint64_t data);
+};
@@ -1,13 +1,32 @@
 #include "Game.h"
 #include <SDL3/SDL.h>
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    // --threaded-sim runs the fixed-step simulation on its own thread
+    // --seed N deals a fixed board
+    // --record FILE saves the game on exit; --replay FILE plays one back
+    GameOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(argv[i], "--threaded-sim") == 0) {
+            options.threadedSimulation = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && value) {
+            options.seed = std::strtoull(value, nullptr, 10);
+            ++i;
+        } else if (std::strcmp(argv[i], "--record") == 0 && value) {
+            options.recordPath = value;
+            ++i;
+        } else if (std::strcmp(argv[i], "--replay") == 0 && value) {
+            options.replayPath = value;
+            ++i;
+        }
+    }
 
     Game game;
 
-    if (!game.init()) {
+    if (!game.init(options)) {
         SDL_Log("Failed to initialize game!");
         return 1;
     }
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include "BoardCorpus.h"
+#include "TestHelpers.h"
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+bool sameCells(const BoardState& a, const BoardState& b) {
+    return boardToString(a) == boardToString(b);
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+} // namespace
+
+TEST_CASE("Board packing", "[corpus]") {
+    SECTION("An 8x8 board packs into 24 bytes") {
+        CHECK(packedBoardSize(BoardState::CELLS) == 24);
+        CHECK(packedBoardSize(10 * 12) == 45);
+    }
+
+    SECTION("Boards survive a round trip, empty cells included") {
+        for (unsigned seed = 1; seed <= 50; ++seed) {
+            BoardState board = randomBoard(seed, static_cast<int>(GemType::COUNT), 20);
+            uint8_t packed[24];
+            packBoard(board, packed);
+
+            BoardState unpacked;
+            unpackBoard(packed, unpacked);
+            CHECK(sameCells(board, unpacked));
+            CHECK(bitboardsConsistent(unpacked));
+            CHECK(unpacked.hash() == board.hash());
+
+            bool cellsMatch = true;
+            for (int cell = 0; cell < BoardState::CELLS; ++cell) {
+                cellsMatch = cellsMatch &&
+                    packedCell(packed, cell) == board.at(cell / BoardState::COLS, cell % BoardState::COLS);
+            }
+            CHECK(cellsMatch);
+        }
+    }
+
+    SECTION("Shapes with a partial last group") {
+        using Wide = BasicBoardState<9, 9, 5>;
+        Wide board;
+        for (int row = 0; row < Wide::ROWS; ++row) {
+            for (int col = 0; col < Wide::COLS; ++col) {
+                board.at(row, col) = (row + col) % 7 == 0 ? GemType::EMPTY : static_cast<GemType>((row * 3 + col) % 5);
+            }
+        }
+        std::vector<uint8_t> packed(packedBoardSize(Wide::CELLS));
+        packBoard(board, packed.data());
+
+        Wide unpacked;
+        unpackBoard(packed.data(), unpacked);
+        bool same = true;
+        for (int row = 0; row < Wide::ROWS; ++row) {
+            for (int col = 0; col < Wide::COLS; ++col) {
+                same = same && unpacked.at(row, col) == board.at(row, col);
+            }
+        }
+        CHECK(same);
+        // Padding cells read as empty
+        CHECK(packedCell(packed.data(), Wide::CELLS) == GemType::EMPTY);
+    }
+}
+
+TEST_CASE("Board corpus files", "[corpus]") {
+    const std::string path = "corpus_test.m3b";
+
+    SECTION("Written boards map back in order") {
+        std::vector<BoardState> boards;
+        for (unsigned seed = 1; seed <= 100; ++seed) {
+            boards.push_back(randomBoard(seed, static_cast<int>(GemType::COUNT), 10));
+            boards.back().score = static_cast<int>(seed) * 10;
+        }
+
+        BoardCorpusWriter writer;
+        REQUIRE(writer.open(path, BoardState::ROWS, BoardState::COLS, BoardState::COLORS, true));
+        for (const BoardState& board : boards) {
+            REQUIRE(writer.write(board));
+        }
+        REQUIRE(writer.close());
+        CHECK(readFile(path).size() == BOARD_CORPUS_HEADER_SIZE + boards.size() * 28);
+
+        MappedBoardCorpus corpus;
+        REQUIRE(corpus.open(path));
+        CHECK(corpus.size() == boards.size());
+        CHECK(corpus.getRows() == BoardState::ROWS);
+        CHECK(corpus.getCols() == BoardState::COLS);
+        CHECK(corpus.hasScores());
+
+        size_t index = 0;
+        bool allSame = true;
+        BoardState state;
+        for (PackedBoard board : corpus) {
+            REQUIRE(board.unpack(state));
+            allSame = allSame && sameCells(state, boards[index]) && state.score == boards[index].score;
+            ++index;
+        }
+        CHECK(index == boards.size());
+        CHECK(allSame);
+
+        // Random access reads in place
+        CHECK(corpus[42].at(3, 5) == boards[42].at(3, 5));
+        CHECK(corpus[99].score() == 1000);
+
+        // Another shape is refused
+        BasicBoardState<9, 9, 5> other;
+        CHECK_FALSE(corpus[0].unpack(other));
+
+        corpus.close();
+        std::remove(path.c_str());
+    }
+
+    SECTION("Writers refuse boards of another shape") {
+        BoardCorpusWriter writer;
+        REQUIRE(writer.open(path, 9, 9, 5));
+        CHECK_FALSE(writer.write(noMatchBoard()));
+        CHECK(writer.write(BasicBoardState<9, 9, 5>()));
+        CHECK(writer.close());
+        std::remove(path.c_str());
+    }
+
+    SECTION("Damaged files are refused") {
+        BoardCorpusWriter writer;
+        REQUIRE(writer.open(path, BoardState::ROWS, BoardState::COLS, BoardState::COLORS));
+        for (unsigned seed = 1; seed <= 10; ++seed) {
+            writer.write(randomBoard(seed));
+        }
+        REQUIRE(writer.close());
+        std::vector<uint8_t> data = readFile(path);
+
+        MappedBoardCorpus corpus;
+        std::vector<uint8_t> badMagic = data;
+        badMagic[0] = 'X';
+        writeFile(path, badMagic);
+        CHECK_FALSE(corpus.open(path));
+
+        std::vector<uint8_t> badVersion = data;
+        badVersion[4] = BOARD_CORPUS_VERSION + 1;
+        writeFile(path, badVersion);
+        CHECK_FALSE(corpus.open(path));
+
+        std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+        writeFile(path, truncated);
+        CHECK_FALSE(corpus.open(path));
+
+        // Count claims more boards than the file holds
+        std::vector<uint8_t> badCount = data;
+        badCount[16] = 11;
+        writeFile(path, badCount);
+        CHECK_FALSE(corpus.open(path));
+
+        std::vector<uint8_t> headerOnly(data.begin(), data.begin() + 16);
+        writeFile(path, headerOnly);
+        CHECK_FALSE(corpus.open(path));
+
+        writeFile(path, data);
+        CHECK(corpus.open(path));
+        CHECK(corpus.size() == 10);
+        corpus.close();
+
+        std::remove(path.c_str());
+        CHECK_FALSE(corpus.open("no/such/corpus.m3b"));
+    }
+}
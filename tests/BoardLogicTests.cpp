@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include "BoardLogic.h"
 #include "TestHelpers.h"
+#include "BitUtils.h"
+#include "SimdLevel.h"
+#include <algorithm>
 
 // ============================================================================
 // Match Detection Tests
@@ -104,6 +107,120 @@ TEST_CASE("Combined matches", "[matches]") {
     }
 }
 
+// Straightforward run scan used as the reference for the bitboard matcher
+template <typename State>
+static StaticVector<Position, State::CELLS> referenceMatches(const State& state) {
+    bool matched[State::ROWS][State::COLS] = {};
+    for (int row = 0; row < State::ROWS; ++row) {
+        for (int col = 0; col < State::COLS; ++col) {
+            GemType type = state.at(row, col);
+            if (type == GemType::EMPTY) continue;
+            int right = col;
+            while (right + 1 < State::COLS && state.at(row, right + 1) == type) ++right;
+            if (right - col >= 2) {
+                for (int c = col; c <= right; ++c) matched[row][c] = true;
+            }
+            int down = row;
+            while (down + 1 < State::ROWS && state.at(down + 1, col) == type) ++down;
+            if (down - row >= 2) {
+                for (int r = row; r <= down; ++r) matched[r][col] = true;
+            }
+        }
+    }
+    StaticVector<Position, State::CELLS> positions;
+    for (int row = 0; row < State::ROWS; ++row) {
+        for (int col = 0; col < State::COLS; ++col) {
+            if (matched[row][col]) positions.push_back({row, col});
+        }
+    }
+    return positions;
+}
+
+TEST_CASE("Bitboard matcher agrees with reference scan", "[matches]") {
+    BoardLogic logic;
+
+    SECTION("Runs do not wrap across row edges") {
+        auto state = noMatchBoard();
+        state.at(0, 6) = GemType::PURPLE;
+        state.at(0, 7) = GemType::PURPLE;
+        state.at(1, 0) = GemType::PURPLE;
+
+        CHECK(logic.checkMatches(state).matchedPositions.empty());
+    }
+
+    SECTION("Random boards produce identical sorted positions and score") {
+        for (unsigned seed = 0; seed < 500; ++seed) {
+            auto state = randomBoard(seed, 3 + seed % 4, seed % 3 == 0 ? 20 : 0);
+            auto expected = referenceMatches(state);
+            auto result = logic.checkMatches(state);
+
+            REQUIRE(result.matchedPositions == expected);
+            CHECK(result.score == static_cast<int>(expected.size()) * 10);
+        }
+    }
+}
+
+TEST_CASE("Incremental match detection", "[matches][dirty]") {
+    BoardLogic logic;
+
+    SECTION("Returns the whole run through a dirty cell") {
+        auto state = noMatchBoard();
+        for (int col = 0; col < 5; ++col) {
+            state.at(0, col) = GemType::PURPLE;
+        }
+
+        auto result = logic.checkMatches(state, BoardState::bit(0, 4));
+
+        CHECK(result.matchedPositions.size() == 5);
+        CHECK(result.score == 50);
+    }
+
+    SECTION("Ignores runs that contain no dirty cell") {
+        auto state = noMatchBoard();
+        state.at(0, 0) = GemType::PURPLE;
+        state.at(0, 1) = GemType::PURPLE;
+        state.at(0, 2) = GemType::PURPLE;
+        state.at(5, 5) = GemType::ORANGE;
+        state.at(6, 5) = GemType::ORANGE;
+        state.at(7, 5) = GemType::ORANGE;
+
+        auto result = logic.checkMatches(state, BoardState::bit(6, 5));
+
+        CHECK(result.matchedPositions.size() == 3);
+        CHECK(containsPosition(result.matchedPositions, 5, 5));
+        CHECK_FALSE(containsPosition(result.matchedPositions, 0, 0));
+    }
+
+    SECTION("Matches a full scan after swaps and cascades on stable boards") {
+        BoardLogic seeded(uint64_t{42});
+
+        for (int board = 0; board < 20; ++board) {
+            BoardState initial;
+            seeded.initializeBoard(initial);
+
+            for (int row = 0; row < BoardState::ROWS; ++row) {
+                for (int col = 0; col + 1 < BoardState::COLS; ++col) {
+                    BoardState state = initial;
+                    Bitboard dirty = seeded.executeSwap(state, {{row, col}, {row, col + 1}});
+                    auto full = seeded.checkMatches(state);
+
+                    // Follow the cascade, comparing both scans at every step
+                    while (true) {
+                        auto incremental = seeded.checkMatches(state, dirty);
+                        REQUIRE(incremental.matchedPositions == full.matchedPositions);
+                        if (full.matchedPositions.empty()) break;
+
+                        seeded.removeMatches(state, full.matchedPositions);
+                        auto gravity = seeded.applyGravity(state);
+                        dirty = gravity.dirty | seeded.fillEmpty(state, gravity.emptyPositions);
+                        full = seeded.checkMatches(state);
+                    }
+                }
+            }
+        }
+    }
+}
+
 // ============================================================================
 // Gravity Tests
 // ============================================================================
@@ -249,6 +366,90 @@ TEST_CASE("Valid moves detection", "[moves]") {
     }
 }
 
+// Try every swap on a copy of the board, as a reference for the templates
+template <typename Logic>
+static std::vector<Move> referenceValidMoves(const Logic& logic, const typename Logic::State& state) {
+    std::vector<Move> moves;
+    for (int row = 0; row < Logic::State::ROWS; ++row) {
+        for (int col = 0; col < Logic::State::COLS; ++col) {
+            if (state.at(row, col) == GemType::EMPTY) continue;
+            const Position neighbors[] = {{row, col + 1}, {row + 1, col}};
+            for (const auto& to : neighbors) {
+                if (!state.isValid(to.row, to.col) || state.at(to.row, to.col) == GemType::EMPTY) continue;
+                auto temp = state;
+                temp.swap(row, col, to.row, to.col);
+                if (logic.wouldCreateMatch(temp, row, col, temp.at(row, col)) ||
+                    logic.wouldCreateMatch(temp, to.row, to.col, temp.at(to.row, to.col))) {
+                    moves.push_back({{row, col}, to});
+                }
+            }
+        }
+    }
+    return moves;
+}
+
+static bool sameMoves(const std::vector<Move>& a, const std::vector<Move>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!(a[i].from == b[i].from) || !(a[i].to == b[i].to)) return false;
+    }
+    return true;
+}
+
+TEST_CASE("Move templates agree with trying every swap", "[moves]") {
+    BoardLogic logic;
+    std::vector<Move> moves;
+
+    SECTION("Finds the X X _ X shape") {
+        auto state = noMatchBoard();
+        state.at(3, 0) = GemType::PURPLE;
+        state.at(3, 1) = GemType::PURPLE;
+        state.at(3, 3) = GemType::PURPLE;
+
+        logic.enumerateValidMoves(state, moves);
+
+        REQUIRE(moves.size() == 1);
+        CHECK(moves[0].from == Position{3, 2});
+        CHECK(moves[0].to == Position{3, 3});
+        CHECK(logic.countValidMoves(state) == 1);
+    }
+
+    SECTION("Finds the X _ X shape completed from below") {
+        auto state = noMatchBoard();
+        state.at(3, 2) = GemType::PURPLE;
+        state.at(3, 4) = GemType::PURPLE;
+        state.at(4, 3) = GemType::PURPLE;
+
+        logic.enumerateValidMoves(state, moves);
+
+        REQUIRE(moves.size() == 1);
+        CHECK(moves[0].from == Position{3, 3});
+        CHECK(moves[0].to == Position{4, 3});
+    }
+
+    SECTION("Templates do not wrap across row edges") {
+        auto state = noMatchBoard();
+        state.at(2, 6) = GemType::PURPLE;
+        state.at(2, 7) = GemType::PURPLE;
+        state.at(3, 1) = GemType::PURPLE;
+
+        CHECK(logic.countValidMoves(state) == 0);
+    }
+
+    SECTION("Random boards produce the same moves in the same order") {
+        for (unsigned seed = 0; seed < 500; ++seed) {
+            auto state = randomBoard(seed, 3 + seed % 4, seed % 3 == 0 ? 15 : 0);
+            auto expected = referenceValidMoves(logic, state);
+
+            logic.enumerateValidMoves(state, moves);
+
+            REQUIRE(sameMoves(moves, expected));
+            CHECK(logic.countValidMoves(state) == static_cast<int>(expected.size()));
+            CHECK(logic.hasValidMoves(state) == !expected.empty());
+        }
+    }
+}
+
 // ============================================================================
 // Would Create Match Tests
 // ============================================================================
@@ -328,6 +529,214 @@ TEST_CASE("Execute sequence", "[sequence]") {
     }
 }
 
+TEST_CASE("Execute sequence with a gem generator", "[sequence]") {
+    auto refills = [] {
+        return SequenceGems({
+            GemType::PURPLE, GemType::ORANGE, GemType::YELLOW,
+            GemType::GREEN, GemType::BLUE, GemType::PURPLE,
+            GemType::ORANGE, GemType::YELLOW
+        });
+    };
+    BoardLogic logic;
+
+    auto setUp = [] {
+        auto state = noMatchBoard();
+        state.at(0, 1) = GemType::PURPLE;
+        state.at(1, 1) = GemType::PURPLE;
+        state.at(2, 0) = GemType::PURPLE;
+        state.at(2, 1) = GemType::BLUE;
+        return state;
+    };
+    Move move{{2, 0}, {2, 1}};
+
+    SECTION("Valid swap creates match") {
+        auto state = setUp();
+        auto result = logic.executeSequence(state, move, refills());
+
+        CHECK(result.swapValid == true);
+        CHECK(result.matches.size() >= 1);
+        CHECK(result.totalScore >= 30);
+    }
+
+    SECTION("Same cascade as the factory path") {
+        auto state = setUp();
+        auto factoryState = setUp();
+        BoardLogic factoryLogic(sequenceFactory({
+            GemType::PURPLE, GemType::ORANGE, GemType::YELLOW,
+            GemType::GREEN, GemType::BLUE, GemType::PURPLE,
+            GemType::ORANGE, GemType::YELLOW
+        }));
+
+        auto result = logic.executeSequence(state, move, refills());
+        auto factoryResult = factoryLogic.executeSequence(factoryState, move);
+
+        CHECK(result.totalScore == factoryResult.totalScore);
+        CHECK(result.matches.size() == factoryResult.matches.size());
+        CHECK(boardToString(state) == boardToString(factoryState));
+    }
+
+    SECTION("Invalid swap reverts board") {
+        auto state = noMatchBoard();
+        GemType orig00 = state.at(0, 0);
+        GemType orig01 = state.at(0, 1);
+
+        auto result = logic.executeSequence(state, {{0, 0}, {0, 1}}, refills());
+
+        CHECK(result.swapValid == false);
+        CHECK(result.totalScore == 0);
+        CHECK(state.at(0, 0) == orig00);
+        CHECK(state.at(0, 1) == orig01);
+    }
+}
+
+TEST_CASE("Reused sequence results", "[sequence]") {
+    BoardLogic logic(uint64_t{17});
+    BoardLogic::SequenceResult reused;
+
+    SECTION("Match the by-value results") {
+        for (unsigned seed = 0; seed < 30; ++seed) {
+            BoardState initial;
+            logic.initializeBoard(initial);
+            std::vector<Move> moves;
+            logic.enumerateValidMoves(initial, moves);
+            if (moves.empty()) continue;
+
+            BoardState a = initial;
+            BoardState b = initial;
+            SequenceGems first({GemType::RED, GemType::GREEN, GemType::BLUE, GemType::YELLOW, GemType::RED});
+            SequenceGems second({GemType::RED, GemType::GREEN, GemType::BLUE, GemType::YELLOW, GemType::RED});
+            auto expected = logic.executeSequence(a, moves.front(), first);
+            logic.executeSequence(b, moves.front(), second, reused);
+
+            REQUIRE(reused.swapValid == expected.swapValid);
+            REQUIRE(reused.totalScore == expected.totalScore);
+            REQUIRE(reused.matches.size() == expected.matches.size());
+            for (size_t i = 0; i < expected.matches.size(); ++i) {
+                CHECK(reused.matches[i].matchedPositions == expected.matches[i].matchedPositions);
+                CHECK(reused.gravities[i].emptyPositions == expected.gravities[i].emptyPositions);
+            }
+            CHECK(boardToString(a) == boardToString(b));
+        }
+    }
+
+    SECTION("Invalid swaps reset the previous result") {
+        auto state = noMatchBoard();
+        state.at(0, 1) = GemType::PURPLE;
+        state.at(1, 1) = GemType::PURPLE;
+        state.at(2, 0) = GemType::PURPLE;
+        state.at(2, 1) = GemType::BLUE;
+        logic.executeSequence(state, {{2, 0}, {2, 1}}, reused);
+        REQUIRE(reused.swapValid);
+
+        logic.executeSequence(state, {{7, 7}, {7, 6}}, ConstantGems{GemType::EMPTY}, reused);
+        CHECK_FALSE(reused.swapValid);
+        CHECK(reused.matches.empty());
+        CHECK(reused.gravities.empty());
+        CHECK(reused.totalScore == 0);
+    }
+}
+
+TEST_CASE("Static vector", "[sequence]") {
+    StaticVector<Position, 4> positions;
+    CHECK(positions.empty());
+
+    positions.push_back({1, 2});
+    positions.push_back({3, 4});
+    StaticVector<Position, 4> copy = positions;
+    positions.pop_back();
+
+    CHECK(positions.size() == 1);
+    CHECK(copy.size() == 2);
+    CHECK(copy.back() == Position{3, 4});
+    CHECK(copy != positions);
+    CHECK(StaticVector<Position, 4>({{1, 2}}) == positions);
+    CHECK(containsPosition(copy, 3, 4));
+}
+
+// ============================================================================
+// Board Shape Tests
+// ============================================================================
+
+// Fill a board of any shape from a seed, using `colors` gem types
+template <typename State>
+static State randomShapedBoard(unsigned seed, int colors) {
+    std::mt19937 gen(seed);
+    State state;
+    for (int row = 0; row < State::ROWS; ++row) {
+        for (int col = 0; col < State::COLS; ++col) {
+            state.at(row, col) = static_cast<GemType>(gen() % static_cast<unsigned>(colors));
+        }
+    }
+    return state;
+}
+
+template <typename Logic>
+static void checkShapeAgainstReference() {
+    using State = typename Logic::State;
+    Logic logic;
+    std::vector<Move> moves;
+
+    for (unsigned seed = 0; seed < 200; ++seed) {
+        auto state = randomShapedBoard<State>(seed, 3 + seed % (State::COLORS - 2));
+
+        REQUIRE(logic.checkMatches(state).matchedPositions == referenceMatches(state));
+
+        logic.enumerateValidMoves(state, moves);
+        REQUIRE(sameMoves(moves, referenceValidMoves(logic, state)));
+    }
+
+    State initial;
+    logic.initializeBoard(initial);
+    CHECK(logic.checkMatches(initial).matchedPositions.empty());
+    CHECK(BitUtils::popcount(initial.occupied()) == State::CELLS);
+}
+
+TEST_CASE("Rules work for every compiled board shape", "[shapes]") {
+    SECTION("7x9") {
+        checkShapeAgainstReference<BasicBoardLogic<7, 9, 5>>();
+    }
+
+    SECTION("9x9") {
+        checkShapeAgainstReference<BasicBoardLogic<9, 9, 6>>();
+    }
+
+    SECTION("10x12") {
+        checkShapeAgainstReference<BasicBoardLogic<10, 12, 4>>();
+    }
+
+    SECTION("Runs across the 64-bit word boundary of a wide bitboard") {
+        BasicBoardLogic<10, 12, 6> logic;
+        auto state = randomShapedBoard<BasicBoardLogic<10, 12, 6>::State>(1, 6);
+        // Cells 63-65 are row 5, columns 3-5
+        for (int row = 0; row < 10; ++row) {
+            for (int col = 0; col < 12; ++col) {
+                state.at(row, col) = static_cast<GemType>((row + col) % 4);
+            }
+        }
+        state.at(5, 3) = GemType::ORANGE;
+        state.at(5, 4) = GemType::ORANGE;
+        state.at(5, 5) = GemType::ORANGE;
+
+        auto result = logic.checkMatches(state);
+
+        REQUIRE(result.matchedPositions.size() == 3);
+        CHECK(result.matchedPositions[0] == Position{5, 3});
+        CHECK(result.matchedPositions[2] == Position{5, 5});
+    }
+
+    SECTION("Gravity fills a 9x9 column from the top") {
+        BasicBoardLogic<9, 9, 5> logic;
+        BasicBoardLogic<9, 9, 5>::State state;
+        state.at(0, 8) = GemType::RED;
+
+        auto gravity = logic.applyGravity(state);
+
+        CHECK(state.at(8, 8) == GemType::RED);
+        CHECK(gravity.moves.size() == 1);
+        CHECK(gravity.emptyPositions.size() == 9 * 9 - 1);
+    }
+}
+
 // ============================================================================
 // Edge Cases
 // ============================================================================
@@ -368,6 +777,100 @@ TEST_CASE("Board initialization avoids matches", "[init]") {
     CHECK(result.matchedPositions.empty());
 }
 
+TEST_CASE("Seeded gem generation", "[init][random]") {
+    SECTION("Same seed replays the same board and refills") {
+        BoardLogic first(uint64_t{99});
+        BoardLogic second(uint64_t{99});
+        BoardState a, b;
+
+        first.initializeBoard(a);
+        second.initializeBoard(b);
+        REQUIRE(boardToString(a) == boardToString(b));
+
+        std::vector<Position> column;
+        for (int row = 0; row < BoardState::ROWS; ++row) {
+            a.at(row, 3) = GemType::EMPTY;
+            b.at(row, 3) = GemType::EMPTY;
+            column.push_back({row, 3});
+        }
+        CHECK(first.fillEmpty(a, column) == BoardState::columnMask(3));
+        CHECK(second.fillEmpty(b, column) == BoardState::columnMask(3));
+        CHECK(boardToString(a) == boardToString(b));
+        CHECK(bitboardsConsistent(a));
+    }
+
+    SECTION("Reseeding restarts the sequence") {
+        BoardLogic logic(uint64_t{5});
+        BoardState a, b;
+
+        logic.initializeBoard(a);
+        logic.seed(5);
+        logic.initializeBoard(b);
+
+        CHECK(boardToString(a) == boardToString(b));
+    }
+
+    SECTION("Bulk generation covers every color and nothing else") {
+        BasicBoardLogic<8, 8, 4> logic(uint64_t{1});
+        std::vector<GemType> gems(4001);
+        logic.generateGems(gems.data(), static_cast<int>(gems.size()));
+
+        int counts[4] = {};
+        for (GemType gem : gems) {
+            REQUIRE(static_cast<int>(gem) < 4);
+            ++counts[static_cast<int>(gem)];
+        }
+        for (int count : counts) {
+            CHECK(count > 800);
+            CHECK(count < 1200);
+        }
+    }
+}
+
+TEST_CASE("Gem generators", "[init][random]") {
+    BoardLogic logic;
+
+    SECTION("A generator and a factory wrapping it build the same board") {
+        RandomGems<> direct(7);
+        RandomGems<> wrapped(7);
+        BoardLogic adapted([&wrapped](int row, int col) { return wrapped(row, col); });
+        BoardState a, b;
+
+        logic.initializeBoard(a, direct);
+        adapted.initializeBoard(b);
+
+        CHECK(boardToString(a) == boardToString(b));
+        CHECK(logic.checkMatches(a).matchedPositions.empty());
+    }
+
+    SECTION("Sequence generator cycles") {
+        SequenceGems gems({GemType::RED, GemType::BLUE});
+        auto state = noMatchBoard();
+        std::vector<Position> cells = {{0, 0}, {0, 1}, {0, 2}};
+        for (const auto& pos : cells) state.at(pos.row, pos.col) = GemType::EMPTY;
+
+        logic.fillEmpty(state, cells, gems);
+
+        CHECK(state.at(0, 0) == GemType::RED);
+        CHECK(state.at(0, 1) == GemType::BLUE);
+        CHECK(state.at(0, 2) == GemType::RED);
+    }
+
+    SECTION("Empty refills leave the cascade to visible gems") {
+        auto state = noMatchBoard();
+        state.at(0, 1) = GemType::PURPLE;
+        state.at(1, 1) = GemType::PURPLE;
+        state.at(2, 0) = GemType::PURPLE;
+        state.at(2, 1) = GemType::BLUE;
+
+        auto result = logic.executeSequence(state, {{2, 0}, {2, 1}}, ConstantGems{GemType::EMPTY});
+
+        REQUIRE(result.swapValid);
+        CHECK(state.at(0, 1) == GemType::EMPTY);
+        CHECK(BitUtils::popcount(state.occupied()) == BoardState::CELLS - result.totalScore / 10);
+    }
+}
+
 // ============================================================================
 // Scoring Tests
 // ============================================================================
@@ -513,6 +1016,41 @@ TEST_CASE("Sequence scoring accumulates correctly", "[scoring]") {
     }
 }
 
+TEST_CASE("Sequence scoring with a gem generator", "[scoring]") {
+    SequenceGems refills({
+        GemType::PURPLE, GemType::ORANGE, GemType::YELLOW,
+        GemType::GREEN, GemType::BLUE, GemType::PURPLE,
+        GemType::ORANGE, GemType::YELLOW
+    });
+    BoardLogic logic;
+
+    SECTION("Valid swap updates board state score") {
+        auto state = noMatchBoard();
+        state.at(0, 1) = GemType::PURPLE;
+        state.at(1, 1) = GemType::PURPLE;
+        state.at(2, 0) = GemType::PURPLE;
+        state.at(2, 1) = GemType::BLUE;
+
+        int initialScore = state.score;
+        auto result = logic.executeSequence(state, {{2, 0}, {2, 1}}, refills);
+
+        CHECK(result.swapValid == true);
+        CHECK(result.totalScore >= 30);
+        CHECK(state.score == initialScore + result.totalScore);
+    }
+
+    SECTION("Invalid swap does not change score") {
+        auto state = noMatchBoard();
+        int initialScore = state.score;
+
+        auto result = logic.executeSequence(state, {{0, 0}, {0, 1}}, refills);
+
+        CHECK(result.swapValid == false);
+        CHECK(result.totalScore == 0);
+        CHECK(state.score == initialScore);
+    }
+}
+
 TEST_CASE("Score persists in BoardState", "[scoring]") {
     BoardLogic logic;
 
@@ -535,3 +1073,226 @@ TEST_CASE("Score persists in BoardState", "[scoring]") {
         CHECK(state.score == 100);
     }
 }
+
+// ============================================================================
+// Bitboard Tests
+// ============================================================================
+
+TEST_CASE("Bitboards track cell writes", "[bitboard]") {
+    BoardLogic logic;
+
+    SECTION("Empty board has no bits set") {
+        BoardState state;
+        CHECK(state.occupied() == 0);
+        CHECK(state.mask(GemType::RED) == 0);
+    }
+
+    SECTION("Writing a cell moves its bit between colors") {
+        BoardState state;
+        state.at(2, 3) = GemType::RED;
+        CHECK(state.mask(GemType::RED) == BoardState::bit(2, 3));
+        CHECK(state.occupied() == BoardState::bit(2, 3));
+
+        state.at(2, 3) = GemType::BLUE;
+        CHECK(state.mask(GemType::RED) == 0);
+        CHECK(state.mask(GemType::BLUE) == BoardState::bit(2, 3));
+
+        state.at(2, 3) = GemType::EMPTY;
+        CHECK(state.occupied() == 0);
+        CHECK(bitboardsConsistent(state));
+    }
+
+    SECTION("Swap, remove and gravity keep bitboards in sync") {
+        auto state = noMatchBoard();
+        CHECK(state.occupied() == ~Bitboard(0));
+
+        logic.executeSwap(state, {{0, 0}, {0, 1}});
+        CHECK(bitboardsConsistent(state));
+
+        logic.removeMatches(state, std::vector<Position>{{3, 2}, {4, 2}, {5, 2}});
+        CHECK(bitboardsConsistent(state));
+
+        auto gravity = logic.applyGravity(state);
+        CHECK(gravity.emptyPositions.size() == 3);
+        CHECK(bitboardsConsistent(state));
+
+        logic.fillEmpty(state, gravity.emptyPositions);
+        CHECK(state.occupied() == ~Bitboard(0));
+        CHECK(bitboardsConsistent(state));
+    }
+
+    SECTION("Copied boards carry their bitboards") {
+        auto state = noMatchBoard();
+        BoardState copy = state;
+        copy.at(0, 0) = GemType::PURPLE;
+        CHECK(bitboardsConsistent(state));
+        CHECK(bitboardsConsistent(copy));
+        CHECK(copy.mask(GemType::PURPLE) == BoardState::bit(0, 0));
+    }
+}
+
+TEST_CASE("Zobrist hash tracks the board", "[hash]") {
+    BoardLogic logic(uint64_t{3});
+
+    SECTION("Empty boards hash to zero") {
+        BoardState state;
+        CHECK(state.hash() == 0);
+    }
+
+    SECTION("Swapping back restores the hash") {
+        auto state = noMatchBoard();
+        uint64_t before = state.hash();
+
+        logic.executeSwap(state, {{4, 4}, {4, 5}});
+        CHECK(state.hash() != before);
+        CHECK(hashConsistent(state));
+
+        logic.executeSwap(state, {{4, 4}, {4, 5}});
+        CHECK(state.hash() == before);
+    }
+
+    SECTION("Same layout reached different ways hashes equally") {
+        BoardState a, b;
+        a.at(0, 0) = GemType::RED;
+        a.at(0, 1) = GemType::BLUE;
+        b.at(0, 1) = GemType::GREEN;
+        b.at(0, 0) = GemType::RED;
+        b.at(0, 1) = GemType::BLUE;
+
+        CHECK(a.hash() == b.hash());
+        CHECK(a.hash() != 0);
+    }
+
+    SECTION("Cascades keep the hash consistent") {
+        for (unsigned seed = 0; seed < 50; ++seed) {
+            BoardState state;
+            logic.initializeBoard(state);
+            std::vector<Move> moves;
+            logic.enumerateValidMoves(state, moves);
+            if (moves.empty()) continue;
+
+            logic.executeSequence(state, moves[seed % moves.size()]);
+            REQUIRE(hashConsistent(state));
+        }
+    }
+
+    SECTION("Different boards get different hashes") {
+        std::vector<uint64_t> hashes;
+        for (unsigned seed = 0; seed < 500; ++seed) {
+            hashes.push_back(randomBoard(seed).hash());
+        }
+        std::sort(hashes.begin(), hashes.end());
+        CHECK(std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end());
+    }
+}
+
+// ============================================================================
+// SIMD Level Tests
+// ============================================================================
+
+namespace {
+
+// Restores the SIMD level a test started with
+struct SimdLevelGuard {
+    SimdLevel saved = simdLevel();
+    ~SimdLevelGuard() { setSimdLevel(saved); }
+};
+
+std::vector<SimdLevel> supportedSimdLevels() {
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+        if (simdLevelSupported(level)) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+// Random boards of one shape with matches, gaps and (when sparse) no moves,
+// scanned at every supported level and compared with the scalar loops
+template <typename Logic>
+void checkSimdLevelsAgainstScalar() {
+    using State = typename Logic::State;
+    Logic logic(uint64_t{1});
+    SimdLevelGuard guard;
+
+    for (unsigned seed = 0; seed < 300; ++seed) {
+        std::mt19937 gen(seed);
+        const int emptyPercent = static_cast<int>(seed % 7) * 10;
+        State state;
+        for (int row = 0; row < State::ROWS; ++row) {
+            for (int col = 0; col < State::COLS; ++col) {
+                bool empty = static_cast<int>(gen() % 100) < emptyPercent;
+                state.at(row, col) = empty ? GemType::EMPTY : static_cast<GemType>(gen() % State::COLORS);
+            }
+        }
+
+        setSimdLevel(SimdLevel::SCALAR);
+        const auto matched = logic.findMatchMask(state);
+        const bool hasMoves = logic.hasValidMoves(state);
+        const auto swaps = logic.validSwapMasks(state);
+
+        for (SimdLevel level : supportedSimdLevels()) {
+            INFO("Level " << simdLevelName(level) << ", seed " << seed);
+            REQUIRE(setSimdLevel(level));
+            REQUIRE(logic.findMatchMask(state) == matched);
+            REQUIRE(logic.hasValidMoves(state) == hasMoves);
+            const auto levelSwaps = logic.validSwapMasks(state);
+            REQUIRE(levelSwaps.horizontal == swaps.horizontal);
+            REQUIRE(levelSwaps.vertical == swaps.vertical);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Every SIMD level follows the scalar rules", "[simd]") {
+    SECTION("Scalar and the best level are always supported") {
+        CHECK(simdLevelSupported(SimdLevel::SCALAR));
+        CHECK(simdLevelSupported(bestSimdLevel()));
+    }
+
+    SECTION("Level names round trip") {
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+            CHECK(parseSimdLevel(simdLevelName(level)) == level);
+        }
+        CHECK_FALSE(parseSimdLevel("avx512"));
+    }
+
+    SECTION("Unsupported levels are refused") {
+        SimdLevelGuard guard;
+        SimdLevel before = simdLevel();
+        for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+            if (!simdLevelSupported(level)) {
+                CHECK_FALSE(setSimdLevel(level));
+                CHECK(simdLevel() == before);
+            }
+        }
+    }
+
+    SECTION("8x8 boards") {
+        checkSimdLevelsAgainstScalar<BasicBoardLogic<8, 8, 4>>();
+        checkSimdLevelsAgainstScalar<BasicBoardLogic<8, 8, 5>>();
+        checkSimdLevelsAgainstScalar<BasicBoardLogic<8, 8, 6>>();
+    }
+
+    SECTION("7x9 boards") {
+        checkSimdLevelsAgainstScalar<BasicBoardLogic<7, 9, 4>>();
+        checkSimdLevelsAgainstScalar<BasicBoardLogic<7, 9, 5>>();
+        checkSimdLevelsAgainstScalar<BasicBoardLogic<7, 9, 6>>();
+    }
+
+    SECTION("Move lists match trying every swap at every level") {
+        SimdLevelGuard guard;
+        BoardLogic logic;
+        std::vector<Move> moves;
+        for (SimdLevel level : supportedSimdLevels()) {
+            REQUIRE(setSimdLevel(level));
+            for (unsigned seed = 0; seed < 100; ++seed) {
+                auto state = randomBoard(seed, 3 + seed % 4, seed % 3 == 0 ? 20 : 0);
+                logic.enumerateValidMoves(state, moves);
+                REQUIRE(sameMoves(moves, referenceValidMoves(logic, state)));
+            }
+        }
+    }
+}
@@ -0,0 +1,234 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GemPool.h"
+#include "Grid.h"
+#include "MathUtils.h"
+#include <cmath>
+
+namespace {
+
+void settle(Grid& grid) {
+    for (int step = 0; step < 1000 && grid.isAnimating(); ++step) {
+        grid.update(0.1f);
+    }
+}
+
+int occupiedCells(const BoardState& state) {
+    int count = 0;
+    for (int row = 0; row < Grid::ROWS; ++row) {
+        for (int col = 0; col < Grid::COLS; ++col) {
+            count += state.at(row, col) != GemType::EMPTY;
+        }
+    }
+    return count;
+}
+
+// Every gem on the logic board has a pooled Gem of its type, and every live
+// pool slot belongs to a cell
+bool gemsMatchBoard(const Grid& grid) {
+    const BoardState& state = grid.getBoardState();
+    size_t gemCells = 0;
+    for (int row = 0; row < Grid::ROWS; ++row) {
+        for (int col = 0; col < Grid::COLS; ++col) {
+            Gem gem = grid.getGem(row, col);
+            gemCells += gem ? 1 : 0;
+            GemType type = state.at(row, col);
+            if (type != GemType::EMPTY && (!gem || gem.getType() != type)) {
+                return false;
+            }
+        }
+    }
+    return gemCells == grid.gemCount();
+}
+
+} // namespace
+
+TEST_CASE("Gem pool", "[pool]") {
+    GemPool pool(4);
+
+    SECTION("Acquired gems start at their cell") {
+        GemHandle handle = pool.acquire(2, 3, GemType::BLUE);
+
+        REQUIRE(handle);
+        Gem gem = pool.get(handle);
+        REQUIRE(gem);
+        CHECK(gem.getType() == GemType::BLUE);
+        CHECK(gem.getRow() == 2);
+        CHECK(gem.getCol() == 3);
+        CHECK(gem.getX() == 3.0f);
+        CHECK(gem.getY() == 2.0f);
+        CHECK(gem.getState() == GemState::IDLE);
+        CHECK(pool.size() == 1);
+    }
+
+    SECTION("Released handles go stale") {
+        GemHandle first = pool.acquire(0, 0, GemType::RED);
+        pool.release(first);
+        GemHandle second = pool.acquire(1, 1, GemType::GREEN);
+
+        CHECK(second.index == first.index);
+        CHECK(second != first);
+        CHECK_FALSE(pool.get(first));
+        CHECK(pool.get(second).getType() == GemType::GREEN);
+
+        pool.release(first);  // Stale release is ignored
+        CHECK(pool.get(second));
+        CHECK(pool.size() == 1);
+    }
+
+    SECTION("Full pool returns invalid handles") {
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(pool.acquire(0, i, GemType::RED));
+        }
+
+        CHECK_FALSE(pool.acquire(1, 0, GemType::RED));
+        CHECK(pool.size() == pool.capacity());
+    }
+
+    SECTION("Gems keep their slot while live") {
+        GemHandle handle = pool.acquire(0, 0, GemType::RED);
+        for (int i = 0; i < 3; ++i) {
+            pool.release(pool.acquire(1, i, GemType::BLUE));
+        }
+
+        REQUIRE(pool.get(handle));
+        CHECK(pool.get(handle).getType() == GemType::RED);
+        CHECK_FALSE(pool.get(GemHandle{}));
+    }
+}
+
+TEST_CASE("Gem pool animations", "[pool]") {
+    GemPool pool(4);
+    Gem idle = pool.get(pool.acquire(3, 3, GemType::RED));
+
+    SECTION("Falling gems ease toward their target and land") {
+        Gem gem = pool.get(pool.acquire(0, 1, GemType::BLUE));
+        gem.setY(-1.0f);
+        gem.setTarget(2, 1);
+        gem.setState(GemState::FALLING);
+        REQUIRE(gem.isAnimating());
+
+        pool.update(0.1f);
+        float expected = MathUtils::lerp(-1.0f, 2.0f, MathUtils::smoothstep(0.1f * GemPool::MOVE_SPEED));
+        CHECK(std::abs(gem.getY() - expected) < 1e-5f);
+        CHECK(gem.getX() == 1.0f);
+        CHECK(gem.getState() == GemState::FALLING);
+
+        pool.update(1.0f);
+        CHECK(gem.getState() == GemState::IDLE);
+        CHECK_FALSE(gem.isAnimating());
+        CHECK(gem.getRow() == 2);
+        CHECK(gem.getY() == 2.0f);
+    }
+
+    SECTION("Exploding gems stay put until ready for removal") {
+        Gem gem = pool.get(pool.acquire(1, 2, GemType::GREEN));
+        gem.setState(GemState::EXPLODING);
+
+        pool.update(0.25f);
+        CHECK(gem.getState() == GemState::EXPLODING);
+        CHECK(std::abs(gem.getAnimationProgress() - 0.25f * GemPool::EXPLODE_SPEED) < 1e-6f);
+        CHECK(gem.getX() == 2.0f);
+        CHECK(gem.getY() == 1.0f);
+
+        pool.update(0.5f);
+        CHECK(gem.getState() == GemState::READY_FOR_REMOVAL);
+        CHECK_FALSE(gem.isAnimating());
+    }
+
+    SECTION("A new animation starts from the current position") {
+        Gem gem = pool.get(pool.acquire(0, 0, GemType::YELLOW));
+        gem.setTarget(0, 1);
+        gem.setState(GemState::SWAPPING);
+        pool.update(0.1f);
+        float midX = gem.getX();
+
+        gem.setTarget(0, 0);
+        gem.setState(GemState::SWAPPING);
+        CHECK(gem.getAnimationProgress() == 0.0f);
+        pool.update(0.0f);
+        CHECK(gem.getX() == midX);
+    }
+
+    SECTION("Only animating gems are tracked") {
+        Gem falling = pool.get(pool.acquire(0, 0, GemType::BLUE));
+        GemHandle exploding = pool.acquire(0, 1, GemType::GREEN);
+        CHECK_FALSE(pool.isAnimating());
+
+        falling.setTarget(1, 0);
+        falling.setState(GemState::FALLING);
+        pool.get(exploding).setState(GemState::EXPLODING);
+        falling.setState(GemState::FALLING);  // Re-entering does not double count
+        CHECK(pool.animatingCount() == 2);
+
+        pool.release(exploding);
+        CHECK(pool.animatingCount() == 1);
+
+        pool.update(1.0f);
+        CHECK_FALSE(pool.isAnimating());
+        CHECK(falling.getRow() == 1);
+    }
+
+    SECTION("Render positions blend the last step") {
+        Gem gem = pool.get(pool.acquire(0, 0, GemType::PURPLE));
+        gem.setY(-1.0f);
+        CHECK(gem.getRenderY(0.0f) == -1.0f);  // Placing a gem does not interpolate
+
+        gem.setTarget(0, 0);
+        gem.setState(GemState::FALLING);
+        pool.update(0.1f);
+        float before = -1.0f;
+        float after = gem.getY();
+        CHECK(gem.getRenderY(0.0f) == before);
+        CHECK(gem.getRenderY(1.0f) == after);
+        CHECK(std::abs(gem.getRenderY(0.5f) - (before + after) / 2) < 1e-6f);
+
+        // The step that lands still blends; the one after settles
+        pool.update(1.0f);
+        CHECK(gem.getRenderY(0.0f) == after);
+        CHECK(gem.getRenderY(1.0f) == 0.0f);
+        pool.update(0.1f);
+        CHECK(gem.getRenderY(0.0f) == 0.0f);
+    }
+
+    // Idle gems pass through the animation loop untouched
+    CHECK(idle.getX() == 3.0f);
+    CHECK(idle.getY() == 3.0f);
+    CHECK(idle.getState() == GemState::IDLE);
+}
+
+TEST_CASE("Grid cascades return gems to the pool", "[pool]") {
+    BoardLogic logic;
+    std::vector<Move> moves;
+    int cascades = 0;
+
+    for (uint64_t seed = 1; seed <= 20; ++seed) {
+        Grid grid(seed);
+        REQUIRE(grid.gemCount() == static_cast<size_t>(Grid::ROWS * Grid::COLS));
+        logic.enumerateValidMoves(grid.getBoardState(), moves);
+        if (moves.empty()) continue;
+
+        const Move& move = moves[seed % moves.size()];
+        REQUIRE(grid.swapGems(move.from.row, move.from.col, move.to.row, move.to.col));
+        settle(grid);
+
+        while (logic.findMatchMask(grid.getBoardState()) != 0 && cascades < 500) {
+            ++cascades;
+            grid.checkMatches();
+            grid.removeMatches();
+            // As in Game, gravity runs while the matched gems still explode
+            grid.applyGravity();
+            grid.fillEmpty();
+            CHECK(gemsMatchBoard(grid));
+
+            // Finished explosions are released and their cells refilled
+            settle(grid);
+            grid.applyGravity();
+            grid.fillEmpty();
+            settle(grid);
+            CHECK(gemsMatchBoard(grid));
+            CHECK(occupiedCells(grid.getBoardState()) == Grid::ROWS * Grid::COLS);
+            CHECK(grid.gemCount() == static_cast<size_t>(Grid::ROWS * Grid::COLS));
+        }
+    }
+    CHECK(cascades >= 20);
+}
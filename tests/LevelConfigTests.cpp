@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LevelConfig.h"
+#include <sstream>
+
+TEST_CASE("Level config parsing", "[level]") {
+    SECTION("Reads board shape keys") {
+        std::istringstream in(
+            "# Level 12\n"
+            "rows = 9\n"
+            "cols=9   # square\n"
+            "\n"
+            "colors = 5\n"
+            "moves = 20\n");
+
+        auto level = parseLevelConfig(in);
+
+        REQUIRE(level.has_value());
+        CHECK(level->rows == 9);
+        CHECK(level->cols == 9);
+        CHECK(level->colors == 5);
+    }
+
+    SECTION("Missing keys keep the standard board") {
+        std::istringstream in("colors = 4\n");
+
+        auto level = parseLevelConfig(in);
+
+        REQUIRE(level.has_value());
+        CHECK(level->rows == BoardState::ROWS);
+        CHECK(level->cols == BoardState::COLS);
+        CHECK(level->colors == 4);
+    }
+
+    SECTION("Rejects malformed lines and values") {
+        std::istringstream noEquals("rows 9\n");
+        std::istringstream badValue("rows = nine\n");
+        std::istringstream negative("cols = -3\n");
+
+        CHECK_FALSE(parseLevelConfig(noEquals).has_value());
+        CHECK_FALSE(parseLevelConfig(badValue).has_value());
+        CHECK_FALSE(parseLevelConfig(negative).has_value());
+    }
+
+    SECTION("Loads the sample level") {
+        auto level = loadLevelConfig(MATCH3_LEVELS_DIR "/12.level");
+
+        REQUIRE(level.has_value());
+        CHECK(level->rows == 9);
+        CHECK(level->cols == 9);
+        CHECK(level->colors == 5);
+        CHECK(visitBoardShape(*level, [](auto) {}));
+    }
+
+    SECTION("Missing file fails to load") {
+        CHECK_FALSE(loadLevelConfig("does/not/exist.level").has_value());
+    }
+}
+
+TEST_CASE("Board shape dispatch", "[level]") {
+    SECTION("Visits the compiled shape for the level") {
+        LevelConfig level{10, 12, 5};
+        int rows = 0, cols = 0, colors = 0;
+
+        bool found = visitBoardShape(level, [&](auto shape) {
+            using Shape = decltype(shape);
+            typename Shape::Logic logic;
+            typename Shape::State state;
+            logic.initializeBoard(state);
+            rows = Shape::State::ROWS;
+            cols = Shape::State::COLS;
+            colors = Shape::State::COLORS;
+        });
+
+        CHECK(found);
+        CHECK(rows == 10);
+        CHECK(cols == 12);
+        CHECK(colors == 5);
+    }
+
+    SECTION("Unsupported shapes are reported") {
+        LevelConfig level{6, 6, 6};
+        bool called = false;
+
+        CHECK_FALSE(visitBoardShape(level, [&](auto) { called = true; }));
+        CHECK_FALSE(called);
+    }
+}
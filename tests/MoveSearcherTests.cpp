@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+#include "MoveSearcher.h"
+#include "TestHelpers.h"
+#include <algorithm>
+
+// Bottom row PP.PP with a PURPLE above the gap: swapping it down makes five
+static BoardState fiveInARowBoard() {
+    auto state = noMatchBoard();
+    state.at(7, 0) = GemType::PURPLE;
+    state.at(7, 1) = GemType::PURPLE;
+    state.at(7, 2) = GemType::ORANGE;
+    state.at(7, 3) = GemType::PURPLE;
+    state.at(7, 4) = GemType::PURPLE;
+    state.at(6, 2) = GemType::PURPLE;
+    return state;
+}
+
+TEST_CASE("Move search", "[search]") {
+    SearchConfig config;
+    config.timeBudgetMs = 0.0;
+    config.threads = 1;
+    config.chanceSamples = 2;
+
+    SECTION("No valid moves finds nothing") {
+        MoveSearcher searcher(config);
+        auto result = searcher.search(noMatchBoard());
+
+        CHECK_FALSE(result.found);
+        CHECK(result.depth == 0);
+    }
+
+    SECTION("Prefers the bigger match") {
+        config.maxDepth = 1;
+        MoveSearcher searcher(config);
+        auto result = searcher.search(fiveInARowBoard());
+
+        REQUIRE(result.found);
+        CHECK(result.bestMove.from == Position{6, 2});
+        CHECK(result.bestMove.to == Position{7, 2});
+        CHECK(result.expectedScore >= 50);
+        CHECK(result.depth == 1);
+    }
+
+    SECTION("Deeper search looks further ahead") {
+        config.maxDepth = 2;
+        MoveSearcher searcher(config);
+        auto state = randomBoard(11, 5);
+        BoardLogic logic;
+        std::vector<Move> moves;
+        logic.enumerateValidMoves(state, moves);
+        REQUIRE_FALSE(moves.empty());
+
+        auto result = searcher.search(state);
+
+        REQUIRE(result.found);
+        CHECK(result.depth == 2);
+        CHECK(result.sequences >= moves.size() * 2);
+        CHECK(std::find(moves.begin(), moves.end(), result.bestMove) != moves.end());
+    }
+
+    SECTION("Same result for any thread count") {
+        config.maxDepth = 2;
+        MoveSearcher single(config);
+        config.threads = 4;
+        MoveSearcher parallel(config);
+
+        for (unsigned seed = 20; seed < 25; ++seed) {
+            auto state = randomBoard(seed, 5);
+            auto a = single.search(state);
+            auto b = parallel.search(state);
+
+            REQUIRE(a.found == b.found);
+            CHECK(a.bestMove == b.bestMove);
+            CHECK(a.expectedScore == b.expectedScore);
+        }
+    }
+
+    SECTION("A tiny time budget still completes depth 1") {
+        config.maxDepth = 6;
+        config.timeBudgetMs = 0.001;
+        config.threads = 2;
+        MoveSearcher searcher(config);
+
+        auto result = searcher.search(fiveInARowBoard());
+
+        REQUIRE(result.found);
+        CHECK(result.depth >= 1);
+        CHECK(result.depth < 6);
+    }
+
+    SECTION("Works on other board shapes") {
+        config.maxDepth = 1;
+        BasicMoveSearcher<BasicBoardLogic<10, 12, 4>> searcher(config);
+        BasicBoardLogic<10, 12, 4> logic(uint64_t{8});
+        BasicBoardLogic<10, 12, 4>::State state;
+        logic.initializeBoard(state);
+
+        auto result = searcher.search(state);
+
+        CHECK(result.found == logic.hasValidMoves(state));
+        if (result.found) CHECK(logic.isValidSwap(state, result.bestMove));
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Profiler.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Profiler", "[profiler]") {
+    // The buffer is large, so keep the profiler off the stack
+    auto profiler = std::make_unique<Profiler>();
+
+    SECTION("Events come back oldest first") {
+        profiler->record("first", 100, 10);
+        profiler->record("second", 200, 20);
+
+        std::vector<Profiler::Event> events = profiler->events();
+        REQUIRE(events.size() == 2);
+        CHECK(std::string(events[0].name) == "first");
+        CHECK(events[0].startNs == 100);
+        CHECK(events[0].durationNs == 10);
+        CHECK(std::string(events[1].name) == "second");
+        CHECK(events[0].thread == events[1].thread);
+    }
+
+    SECTION("A full buffer keeps the newest events") {
+        uint64_t total = Profiler::CAPACITY + 10;
+        for (uint64_t i = 0; i < total; ++i) {
+            profiler->record("event", i, 1);
+        }
+
+        std::vector<Profiler::Event> events = profiler->events();
+        REQUIRE(events.size() == Profiler::CAPACITY);
+        CHECK(events.front().startNs == 10);
+        CHECK(events.back().startNs == total - 1);
+        CHECK(profiler->recordedCount() == total);
+    }
+
+    SECTION("Threads record concurrently under their own ids") {
+        const int threadCount = 4;
+        const int perThread = 1000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&profiler, t] {
+                for (int i = 0; i < perThread; ++i) {
+                    profiler->record("work", static_cast<uint64_t>(t), 1);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<Profiler::Event> events = profiler->events();
+        REQUIRE(events.size() == threadCount * perThread);
+
+        // Every event from one writer carries the same thread id
+        std::vector<int64_t> idOfWriter(threadCount, -1);
+        bool consistent = true;
+        for (const Profiler::Event& event : events) {
+            int64_t& id = idOfWriter[event.startNs];
+            if (id == -1) id = event.thread;
+            consistent = consistent && id == event.thread;
+        }
+        CHECK(consistent);
+    }
+
+    SECTION("Scopes record their duration") {
+        Profiler& global = Profiler::instance();
+        uint64_t before = global.recordedCount();
+        {
+            ProfileScope scope("sleep");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        REQUIRE(global.recordedCount() == before + 1);
+        Profiler::Event event = global.events().back();
+        CHECK(std::string(event.name) == "sleep");
+        CHECK(event.durationNs >= 2000000);
+    }
+
+    SECTION("Frame times are kept for the graph") {
+        CHECK(profiler->frameTimes().empty());
+
+        for (size_t i = 0; i < Profiler::FRAME_HISTORY + 5; ++i) {
+            profiler->markFrame();
+        }
+
+        // The first mark only starts the clock
+        std::vector<float> frames = profiler->frameTimes();
+        CHECK(frames.size() == Profiler::FRAME_HISTORY);
+        for (float ms : frames) {
+            CHECK(ms >= 0.0f);
+        }
+    }
+}
+
+TEST_CASE("Profiler Chrome trace export", "[profiler]") {
+    auto profiler = std::make_unique<Profiler>();
+    profiler->record("Grid::update", 1500, 2500);
+    profiler->record("quote\"d", 5000, 1000);
+
+    std::string path = "profiler_test_trace.json";
+    REQUIRE(profiler->writeChromeTrace(path));
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    file.close();
+    std::remove(path.c_str());
+
+    std::string json = contents.str();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    // Complete events, times in microseconds
+    CHECK(json.find("{\"name\":\"Grid::update\",\"ph\":\"X\",\"ts\":1.500,\"dur\":2.500,\"pid\":1,")
+          != std::string::npos);
+    CHECK(json.find("\"name\":\"quote\\\"d\"") != std::string::npos);
+
+    CHECK_FALSE(profiler->writeChromeTrace("no/such/directory/trace.json"));
+}
@@ -0,0 +1,221 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Replay.h"
+#include "Grid.h"
+#include "GemGenerators.h"
+#include <cstdio>
+
+namespace {
+
+// A game of random valid swaps, one every 90 steps, recorded the way the
+// game records it
+Replay randomReplay(uint64_t seed, int maxSwaps) {
+    Replay replay;
+    replay.seed = seed;
+
+    BoardLogic logic(seed);
+    BoardState state;
+    logic.initializeBoard(state);
+
+    Xoshiro256 choice(seed + 1);
+    std::vector<Move> moves;
+    BoardLogic::SequenceResult sequence;
+    ConstantGems noRefills{GemType::EMPTY};
+    for (int i = 0; i < maxSwaps; ++i) {
+        logic.enumerateValidMoves(state, moves);
+        if (moves.empty()) break;
+        Move move = moves[choice.below(static_cast<uint32_t>(moves.size()))];
+        logic.executeSequence(state, move, noRefills, sequence);
+        replay.swaps.push_back(ReplaySwap{static_cast<uint64_t>(i) * 90, move});
+    }
+    replay.finalScore = state.score;
+    return replay;
+}
+
+// Drives a Grid through the replay the way Game does: a swap is taken once
+// the board has settled, then matches, removals and cascades run in the
+// order of Game::updateGameLogic
+int playOnGrid(const Replay& replay) {
+    enum class Phase { PLAYING, CHECKING_MATCHES, REMOVING_MATCHES };
+
+    Grid grid(replay.seed);
+    Phase phase = Phase::PLAYING;
+    size_t next = 0;
+    for (int step = 0; step < 1000000; ++step) {
+        grid.update(1.0f / 120.0f);
+        if (grid.isAnimating()) continue;
+
+        if (phase == Phase::PLAYING) {
+            if (next == replay.swaps.size()) break;
+            const Move& move = replay.swaps[next++].move;
+            if (grid.swapGems(move.from.row, move.from.col, move.to.row, move.to.col)) {
+                phase = Phase::CHECKING_MATCHES;
+            }
+        } else if (phase == Phase::CHECKING_MATCHES) {
+            grid.checkMatches();
+            phase = Phase::REMOVING_MATCHES;
+        } else {
+            grid.removeMatches();
+            grid.applyGravity();
+            grid.checkMatches();
+            if (!grid.isAnimating()) phase = Phase::PLAYING;
+        }
+    }
+    return grid.getScore();
+}
+
+} // namespace
+
+TEST_CASE("Replay encoding", "[replay]") {
+    SECTION("Round trip") {
+        Replay replay = randomReplay(7, 20);
+        REQUIRE(replay.swaps.size() > 1);
+        replay.swaps[1].step += 100000;  // Multi-byte step delta
+
+        std::vector<uint8_t> data = encodeReplay(replay);
+        auto decoded = decodeReplay(data.data(), data.size());
+
+        REQUIRE(decoded);
+        CHECK(decoded->seed == replay.seed);
+        CHECK(decoded->stepRate == replay.stepRate);
+        CHECK(decoded->finalScore == replay.finalScore);
+        CHECK(decoded->swaps.size() == replay.swaps.size());
+        // Moves come back with the top/left cell first
+        bool same = true;
+        for (size_t i = 0; i < replay.swaps.size(); ++i) {
+            const Move& move = replay.swaps[i].move;
+            const Move& back = decoded->swaps[i].move;
+            bool sameCells = (back.from == move.from && back.to == move.to) ||
+                             (back.from == move.to && back.to == move.from);
+            same = same && sameCells && !(back.to < back.from) && decoded->swaps[i].step == replay.swaps[i].step;
+        }
+        CHECK(same);
+    }
+
+    SECTION("Short step gaps take two bytes per swap") {
+        Replay replay;
+        for (int i = 0; i < 100; ++i) {
+            replay.swaps.push_back(ReplaySwap{static_cast<uint64_t>(i) * 100, Move{Position(3, 4), Position(3, 5)}});
+        }
+        std::vector<uint8_t> data = encodeReplay(replay);
+        CHECK(data.size() == 28 + 2 * replay.swaps.size());
+    }
+
+    SECTION("Corrupt data is rejected") {
+        Replay replay = randomReplay(3, 10);
+        std::vector<uint8_t> data = encodeReplay(replay);
+
+        std::vector<uint8_t> badMagic = data;
+        badMagic[0] = 'X';
+        CHECK_FALSE(decodeReplay(badMagic.data(), badMagic.size()));
+
+        std::vector<uint8_t> badVersion = data;
+        badVersion[4] = REPLAY_VERSION + 1;
+        CHECK_FALSE(decodeReplay(badVersion.data(), badVersion.size()));
+
+        std::vector<uint8_t> otherBoard = data;
+        otherBoard[6] = 9;  // Rows
+        CHECK_FALSE(decodeReplay(otherBoard.data(), otherBoard.size()));
+
+        CHECK_FALSE(decodeReplay(data.data(), data.size() - 1));
+        CHECK_FALSE(decodeReplay(data.data(), 10));
+
+        std::vector<uint8_t> trailing = data;
+        trailing.push_back(0);
+        CHECK_FALSE(decodeReplay(trailing.data(), trailing.size()));
+
+        // A horizontal swap off the right edge
+        std::vector<uint8_t> offBoard = data;
+        offBoard.back() = static_cast<uint8_t>((BoardState::COLS - 1) << 1);
+        CHECK_FALSE(decodeReplay(offBoard.data(), offBoard.size()));
+
+        // A huge swap count must fail before allocating
+        std::vector<uint8_t> hugeCount = data;
+        hugeCount[24] = hugeCount[25] = hugeCount[26] = hugeCount[27] = 0xFF;
+        CHECK_FALSE(decodeReplay(hugeCount.data(), hugeCount.size()));
+    }
+
+    SECTION("Files") {
+        Replay replay = randomReplay(11, 15);
+        std::string path = "replay_test.m3r";
+        REQUIRE(saveReplay(replay, path));
+        auto loaded = loadReplay(path);
+        std::remove(path.c_str());
+
+        REQUIRE(loaded);
+        CHECK(loaded->finalScore == replay.finalScore);
+        CHECK(loaded->swaps.size() == replay.swaps.size());
+        CHECK_FALSE(loadReplay("no/such/replay.m3r"));
+    }
+}
+
+TEST_CASE("Replay playback", "[replay]") {
+    SECTION("Headless playback reproduces the recorded score") {
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            Replay replay = randomReplay(seed, 200);
+            ReplayResult result = playReplay(replay);
+            CHECK(result.score == replay.finalScore);
+            CHECK(result.swapsApplied == static_cast<int>(replay.swaps.size()));
+        }
+    }
+
+    SECTION("Headless playback matches the grid the game plays on") {
+        for (uint64_t seed = 1; seed <= 20; ++seed) {
+            Replay replay = randomReplay(seed, 40);
+            CHECK(playOnGrid(replay) == playReplay(replay).score);
+        }
+    }
+
+    SECTION("A swap that makes no match stays, as in the game") {
+        Replay replay;
+        replay.seed = 5;
+        BoardLogic logic(replay.seed);
+        BoardState state;
+        logic.initializeBoard(state);
+
+        // Find a swap of two different gems that makes no match
+        Move quiet{};
+        bool found = false;
+        for (int row = 0; row < BoardState::ROWS && !found; ++row) {
+            for (int col = 0; col + 1 < BoardState::COLS && !found; ++col) {
+                Move move{Position(row, col), Position(row, col + 1)};
+                BoardState copy = state;
+                auto sequence = logic.executeSequence(copy, move, ConstantGems{GemType::EMPTY});
+                if (!sequence.swapValid && state.at(row, col) != state.at(row, col + 1)) {
+                    quiet = move;
+                    found = true;
+                }
+            }
+        }
+        REQUIRE(found);
+        replay.swaps.push_back(ReplaySwap{0, quiet});
+
+        ReplayResult result = playReplay(replay);
+        CHECK(result.swapsApplied == 1);
+        CHECK(result.score == 0);
+        CHECK(playOnGrid(replay) == 0);
+    }
+
+    SECTION("Swaps with an empty cell are skipped") {
+        Replay replay = randomReplay(2, 200);
+        int played = playReplay(replay).swapsApplied;
+
+        // Replaying a swap into an emptied top cell cannot apply
+        BoardLogic logic(replay.seed);
+        BoardState state;
+        logic.initializeBoard(state);
+        ConstantGems noRefills{GemType::EMPTY};
+        for (const ReplaySwap& swap : replay.swaps) {
+            logic.executeSequence(state, swap.move, noRefills);
+        }
+        size_t recorded = replay.swaps.size();
+        for (int col = 0; col + 1 < BoardState::COLS; ++col) {
+            if (state.at(0, col) == GemType::EMPTY) {
+                replay.swaps.push_back(ReplaySwap{replay.swaps.back().step + 1,
+                                                  Move{Position(0, col), Position(0, col + 1)}});
+                break;
+            }
+        }
+        REQUIRE(replay.swaps.size() == recorded + 1);
+        CHECK(playReplay(replay).swapsApplied == played);
+    }
+}
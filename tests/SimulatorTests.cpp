@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Simulator.h"
+#include "ThreadPool.h"
+#include <atomic>
+
+TEST_CASE("Thread pool", "[sim]") {
+    SECTION("Runs every submitted task") {
+        ThreadPool pool(4);
+        std::atomic<int> done{0};
+
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&done] { ++done; });
+        }
+        pool.wait();
+
+        CHECK(done == 1000);
+    }
+
+    SECTION("Waits for tasks submitted by other tasks") {
+        ThreadPool pool(3);
+        std::atomic<int> done{0};
+
+        for (int i = 0; i < 10; ++i) {
+            pool.submit([&pool, &done] {
+                for (int j = 0; j < 10; ++j) {
+                    pool.submit([&done] { ++done; });
+                }
+            });
+        }
+        pool.wait();
+
+        CHECK(done == 100);
+    }
+
+    SECTION("Can be reused after wait") {
+        ThreadPool pool(2);
+        std::atomic<int> done{0};
+
+        pool.submit([&done] { ++done; });
+        pool.wait();
+        pool.submit([&done] { ++done; });
+        pool.wait();
+
+        CHECK(done == 2);
+    }
+}
+
+TEST_CASE("Batch simulation", "[sim]") {
+    SimulationConfig config;
+    config.games = 40;
+    config.maxMoves = 30;
+    config.seed = 7;
+
+    SECTION("Plays the requested number of games") {
+        auto stats = runSimulation(config);
+
+        REQUIRE(stats.has_value());
+        CHECK(stats->games == 40);
+        CHECK(stats->shortestGame <= stats->longestGame);
+        CHECK(stats->longestGame <= config.maxMoves);
+        CHECK(stats->totalMoves > 0);
+    }
+
+    SECTION("Same seed gives the same results for any thread count") {
+        config.policy = MovePolicy::GREEDY;
+        config.threads = 1;
+        auto single = runSimulation(config);
+        config.threads = 4;
+        auto multi = runSimulation(config);
+
+        REQUIRE(single.has_value());
+        REQUIRE(multi.has_value());
+        CHECK(single->totalScore == multi->totalScore);
+        CHECK(single->totalMoves == multi->totalMoves);
+        CHECK(single->cascadeDepths == multi->cascadeDepths);
+    }
+
+    SECTION("Unsupported board shapes are rejected") {
+        config.level.rows = 3;
+
+        CHECK_FALSE(runSimulation(config).has_value());
+    }
+}
+
+TEST_CASE("Move policy names", "[sim]") {
+    CHECK(parseMovePolicy("greedy") == MovePolicy::GREEDY);
+    CHECK(parseMovePolicy("first") == MovePolicy::FIRST_VALID);
+    CHECK(parseMovePolicy("search") == MovePolicy::SEARCH);
+    CHECK(std::string(movePolicyName(MovePolicy::RANDOM)) == "random");
+    CHECK_FALSE(parseMovePolicy("smart").has_value());
+}
@@ -2,9 +2,11 @@
 
 #include "BoardTypes.h"
 #include "BoardLogic.h"
+#include "GemGenerators.h"
 #include <string>
 #include <vector>
 #include <memory>
+#include <random>
 
 // Parse board state from ASCII art for readable tests
 // Characters: R=Red, G=Green, B=Blue, Y=Yellow, P=Purple, O=Orange, .=Empty
@@ -77,7 +79,7 @@ inline GemFactory constantFactory(GemType type) {
 }
 
 // Check if a position is in a list of positions
-inline bool containsPosition(const std::vector<Position>& positions, int row, int col) {
+inline bool containsPosition(PositionSpan positions, int row, int col) {
     for (const auto& pos : positions) {
         if (pos.row == row && pos.col == col) {
             return true;
@@ -86,6 +88,36 @@ inline bool containsPosition(const std::vector<Position>& positions, int row, in
     return false;
 }
 
+// Check that the per-color bitboards agree with the gem array
+inline bool bitboardsConsistent(const BoardState& state) {
+    Bitboard occupied = 0;
+    Bitboard colors[static_cast<int>(GemType::COUNT)] = {};
+    for (int row = 0; row < BoardState::ROWS; ++row) {
+        for (int col = 0; col < BoardState::COLS; ++col) {
+            GemType type = state.at(row, col);
+            if (BoardState::isGem(type)) {
+                colors[static_cast<int>(type)] |= BoardState::bit(row, col);
+                occupied |= BoardState::bit(row, col);
+            }
+        }
+    }
+    for (int i = 0; i < static_cast<int>(GemType::COUNT); ++i) {
+        if (state.mask(static_cast<GemType>(i)) != colors[i]) return false;
+    }
+    return state.occupied() == occupied;
+}
+
+// Check that the incremental hash matches one built from an empty board
+inline bool hashConsistent(const BoardState& state) {
+    BoardState rebuilt;
+    for (int row = 0; row < BoardState::ROWS; ++row) {
+        for (int col = 0; col < BoardState::COLS; ++col) {
+            rebuilt.at(row, col) = state.at(row, col);
+        }
+    }
+    return rebuilt.hash() == state.hash();
+}
+
 // Create a board with no matches using a repeating pattern
 // Pattern ensures no 3-in-a-row horizontally or vertically
 inline BoardState noMatchBoard() {
@@ -101,3 +133,20 @@ inline BoardState noMatchBoard() {
     }
     return state;
 }
+
+// Create a reproducible random board, optionally limited to the first
+// `colors` gem types and with some cells left empty
+inline BoardState randomBoard(unsigned seed, int colors = static_cast<int>(GemType::COUNT),
+                              int emptyPercent = 0) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> color(0, colors - 1);
+    std::uniform_int_distribution<> percent(0, 99);
+    BoardState state;
+    for (int row = 0; row < BoardState::ROWS; ++row) {
+        for (int col = 0; col < BoardState::COLS; ++col) {
+            bool empty = percent(gen) < emptyPercent;
+            state.at(row, col) = empty ? GemType::EMPTY : static_cast<GemType>(color(gen));
+        }
+    }
+    return state;
+}
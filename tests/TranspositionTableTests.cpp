@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include "TranspositionTable.h"
+#include "TestHelpers.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Transposition table", "[hash]") {
+    TranspositionTable table(1000);
+
+    SECTION("Capacity is a power of two") {
+        CHECK(table.capacity() == 512);
+        CHECK(TranspositionTable(0).capacity() == 1);
+    }
+
+    SECTION("Stores and probes entries") {
+        auto state = noMatchBoard();
+        TranspositionTable::Entry entry;
+        entry.score = -1234;
+        entry.depth = 3;
+        entry.validMoves = 17;
+        entry.hasBestMove = true;
+        entry.bestMove = {{9, 11}, {9, 10}};
+
+        CHECK_FALSE(table.probe(state.hash()).has_value());
+        table.store(state.hash(), entry);
+
+        auto found = table.probe(state.hash());
+        REQUIRE(found.has_value());
+        CHECK(found->score == -1234);
+        CHECK(found->depth == 3);
+        CHECK(found->validMoves == 17);
+        CHECK(found->hasBestMove);
+        CHECK(found->bestMove.from == Position{9, 11});
+        CHECK(found->bestMove.to == Position{9, 10});
+    }
+
+    SECTION("Other positions in the same slot miss") {
+        TranspositionTable::Entry entry;
+        table.store(5, entry);
+
+        CHECK(table.probe(5).has_value());
+        CHECK_FALSE(table.probe(5 + table.capacity()).has_value());
+        CHECK_FALSE(table.probe(0).has_value());
+    }
+
+    SECTION("Deeper results of the same position are kept") {
+        TranspositionTable::Entry deep;
+        deep.depth = 4;
+        deep.score = 100;
+        TranspositionTable::Entry shallow;
+        shallow.depth = 1;
+        shallow.score = 50;
+
+        table.store(42, deep);
+        table.store(42, shallow);
+        CHECK(table.probe(42)->score == 100);
+
+        table.store(42 + table.capacity(), shallow);
+        CHECK_FALSE(table.probe(42).has_value());
+    }
+
+    SECTION("Clear empties the table") {
+        table.store(7, TranspositionTable::Entry{});
+        table.clear();
+        CHECK_FALSE(table.probe(7).has_value());
+    }
+
+    SECTION("Concurrent writers never produce torn entries") {
+        // Scores are derived from keys, so a slot mixing two writes would show
+        TranspositionTable small(16);
+        std::atomic<int> torn{0};
+        auto keyOf = [](int i) { return static_cast<uint64_t>(i + 1) * 0x9E3779B97F4A7C15ull; };
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = t; i < 80000; i += 4) {
+                    TranspositionTable::Entry entry;
+                    entry.score = static_cast<int32_t>(keyOf(i) >> 40);
+                    entry.depth = static_cast<uint8_t>(i % 100);
+                    small.store(keyOf(i), entry);
+
+                    int other = (i * 7) % 80000;
+                    auto found = small.probe(keyOf(other));
+                    if (found && (found->score != static_cast<int32_t>(keyOf(other) >> 40) ||
+                                  found->depth != other % 100)) {
+                        ++torn;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        CHECK(torn == 0);
+    }
+}
@@ -0,0 +1,216 @@
+// Board corpus tool: converts between the ASCII boards used by the tests and
+// the binary corpus format (BoardCorpus.h), generates corpora and scans them.
+
+#include "BoardCorpus.h"
+#include "LevelConfig.h"
+#include "TestHelpers.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void printUsage(const char* program) {
+    std::printf(
+        "Usage: %s COMMAND [arguments]\n"
+        "\n"
+        "Commands:\n"
+        "  pack IN.txt OUT.m3b        Convert ASCII boards (8x8, blank-line separated) to a corpus\n"
+        "  unpack IN.m3b [LIMIT]      Print a corpus as ASCII boards\n"
+        "  generate N OUT.m3b [SEED] [LEVEL]\n"
+        "                             Write N random boards without matches\n"
+        "  info IN.m3b                Print the header and time a scan of every board\n",
+        program);
+}
+
+bool parseNumber(const char* text, unsigned long long& value) {
+    char* end = nullptr;
+    value = std::strtoull(text, &end, 10);
+    return end && end != text && *end == '\0';
+}
+
+int pack(const char* inPath, const char* outPath) {
+    std::ifstream in(inPath);
+    if (!in) {
+        std::fprintf(stderr, "Could not read %s\n", inPath);
+        return 1;
+    }
+    BoardCorpusWriter writer;
+    if (!writer.open(outPath, BoardState::ROWS, BoardState::COLS, BoardState::COLORS)) {
+        std::fprintf(stderr, "Could not write %s\n", outPath);
+        return 1;
+    }
+
+    std::vector<std::string> rows;
+    std::string line;
+    int lineNumber = 0;
+    bool ok = true;
+    while (ok && std::getline(in, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (static_cast<int>(line.size()) != BoardState::COLS) {
+            std::fprintf(stderr, "%s:%d: expected %d cells\n", inPath, lineNumber, BoardState::COLS);
+            return 1;
+        }
+        rows.push_back(line);
+        if (static_cast<int>(rows.size()) == BoardState::ROWS) {
+            ok = writer.write(parseBoard(rows));
+            rows.clear();
+        }
+    }
+    if (!rows.empty()) {
+        std::fprintf(stderr, "%s: last board is incomplete\n", inPath);
+        return 1;
+    }
+    if (!writer.close() || !ok) {
+        std::fprintf(stderr, "Could not write %s\n", outPath);
+        return 1;
+    }
+    std::printf("Packed %llu boards\n", static_cast<unsigned long long>(writer.size()));
+    return 0;
+}
+
+int unpack(const char* inPath, unsigned long long limit) {
+    MappedBoardCorpus corpus;
+    if (!corpus.open(inPath)) {
+        std::fprintf(stderr, "Could not open corpus %s\n", inPath);
+        return 1;
+    }
+    if (corpus.getRows() != BoardState::ROWS || corpus.getCols() != BoardState::COLS ||
+        corpus.getColors() != BoardState::COLORS) {
+        std::fprintf(stderr, "Only %dx%d boards with %d colors can be printed\n",
+                     BoardState::ROWS, BoardState::COLS, BoardState::COLORS);
+        return 1;
+    }
+
+    BoardState state;
+    unsigned long long printed = 0;
+    for (PackedBoard board : corpus) {
+        if (printed++ == limit) break;
+        board.unpack(state);
+        for (const std::string& row : boardToString(state)) {
+            std::printf("%s\n", row.c_str());
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
+
+int generate(unsigned long long count, const char* outPath, uint64_t seed, const LevelConfig& level) {
+    bool ok = false;
+    bool shapeKnown = visitBoardShape(level, [&](auto shape) {
+        using Shape = decltype(shape);
+        BoardCorpusWriter writer;
+        if (!writer.open(outPath, level.rows, level.cols, level.colors)) {
+            return;
+        }
+        typename Shape::Logic logic(seed);
+        typename Shape::State state;
+        bool written = true;
+        for (unsigned long long i = 0; i < count && written; ++i) {
+            logic.initializeBoard(state);
+            written = writer.write(state);
+        }
+        ok = writer.close() && written;
+    });
+
+    if (!shapeKnown) {
+        std::fprintf(stderr, "No compiled rules for a %dx%d board with %d colors\n",
+                     level.rows, level.cols, level.colors);
+        return 1;
+    }
+    if (!ok) {
+        std::fprintf(stderr, "Could not write %s\n", outPath);
+        return 1;
+    }
+    std::printf("Generated %llu boards\n", count);
+    return 0;
+}
+
+int info(const char* inPath) {
+    auto start = Clock::now();
+    MappedBoardCorpus corpus;
+    if (!corpus.open(inPath)) {
+        std::fprintf(stderr, "Could not open corpus %s\n", inPath);
+        return 1;
+    }
+    double openMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Touch every cell, as a consumer reading each board in place would
+    start = Clock::now();
+    uint64_t gems[8] = {};
+    int cells = corpus.getRows() * corpus.getCols();
+    for (PackedBoard board : corpus) {
+        for (int cell = 0; cell < cells; ++cell) {
+            ++gems[static_cast<int>(packedCell(board.data(), cell))];
+        }
+    }
+    double scanSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("Board:    %dx%d, %d colors%s\n", corpus.getRows(), corpus.getCols(), corpus.getColors(),
+                corpus.hasScores() ? ", with scores" : "");
+    std::printf("Boards:   %llu\n", static_cast<unsigned long long>(corpus.size()));
+    std::printf("Open:     %.3f ms\n", openMs);
+    std::printf("Scan:     %.3f s (%.0f boards per second)\n", scanSeconds,
+                scanSeconds > 0.0 ? corpus.size() / scanSeconds : 0.0);
+    std::printf("Empty:    %llu cells\n", static_cast<unsigned long long>(gems[static_cast<int>(GemType::EMPTY)]));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::strcmp(argv[1], "--help") == 0) {
+        printUsage(argv[0]);
+        return argc < 2 ? 1 : 0;
+    }
+
+    std::string command = argv[1];
+    unsigned long long number = 0;
+
+    if (command == "pack" && argc == 4) {
+        return pack(argv[2], argv[3]);
+    }
+    if (command == "unpack" && (argc == 3 || argc == 4)) {
+        unsigned long long limit = ~0ull;
+        if (argc == 4 && !parseNumber(argv[3], limit)) {
+            std::fprintf(stderr, "Invalid limit: %s\n", argv[3]);
+            return 1;
+        }
+        return unpack(argv[2], limit);
+    }
+    if (command == "generate" && argc >= 4 && argc <= 6) {
+        if (!parseNumber(argv[2], number)) {
+            std::fprintf(stderr, "Invalid board count: %s\n", argv[2]);
+            return 1;
+        }
+        unsigned long long seed = 1;
+        if (argc >= 5 && !parseNumber(argv[4], seed)) {
+            std::fprintf(stderr, "Invalid seed: %s\n", argv[4]);
+            return 1;
+        }
+        LevelConfig level;
+        if (argc == 6) {
+            auto loaded = loadLevelConfig(argv[5]);
+            if (!loaded) {
+                std::fprintf(stderr, "Could not read level file: %s\n", argv[5]);
+                return 1;
+            }
+            level = *loaded;
+        }
+        return generate(number, argv[3], seed, level);
+    }
+    if (command == "info" && argc == 3) {
+        return info(argv[2]);
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}
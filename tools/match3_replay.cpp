@@ -0,0 +1,188 @@
+// Headless replay runner: plays recorded games (saved with the game's
+// --record option) at full speed on all cores, checks each final score
+// against the recorded one and reports playback timings. Exits with status 1
+// when a replay fails to load or its score differs, so a corpus of
+// recordings works as a regression test.
+
+#include "Replay.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* REPLAY_EXTENSION = ".m3r";
+
+struct Entry {
+    std::string path;
+    std::optional<Replay> replay;
+    ReplayResult result;
+    double microseconds = 0.0;
+};
+
+void printUsage(const char* program) {
+    std::printf(
+        "Usage: %s [options] PATH...\n"
+        "\n"
+        "Plays every replay given, and every %s file under each directory given.\n"
+        "\n"
+        "Options:\n"
+        "  --threads N     Worker threads, 0 = all cores (default 0)\n"
+        "  --verbose       Print one line per replay\n"
+        "  --json          Print the summary as JSON\n"
+        "  --help          Show this message\n",
+        program, REPLAY_EXTENSION);
+}
+
+bool collectPaths(const std::string& path, std::vector<std::string>& paths) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(path, error)) {
+        paths.push_back(path);
+        return true;
+    }
+
+    std::vector<std::string> found;
+    for (std::filesystem::recursive_directory_iterator it(path, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file(error) && it->path().extension() == REPLAY_EXTENSION) {
+            found.push_back(it->path().string());
+        }
+    }
+    if (error) {
+        std::fprintf(stderr, "Could not read directory %s: %s\n", path.c_str(), error.message().c_str());
+        return false;
+    }
+    // Stable order, so runs over the same corpus print the same way
+    std::sort(found.begin(), found.end());
+    paths.insert(paths.end(), found.begin(), found.end());
+    return true;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned threads = 0;
+    bool verbose = false;
+    bool json = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else if (arg == "--json") {
+            json = true;
+        } else if (arg == "--threads") {
+            char* end = nullptr;
+            const char* value = i + 1 < argc ? argv[++i] : "";
+            threads = static_cast<unsigned>(std::strtoul(value, &end, 10));
+            if (end == value || *end != '\0') {
+                std::fprintf(stderr, "Invalid number for --threads: %s\n", value);
+                return 1;
+            }
+        } else if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            printUsage(argv[0]);
+            return 1;
+        } else if (!collectPaths(arg, paths)) {
+            return 1;
+        }
+    }
+
+    if (paths.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Load everything first so the timings below cover playback only
+    std::vector<Entry> entries(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        entries[i].path = paths[i];
+        entries[i].replay = loadReplay(paths[i]);
+    }
+
+    auto start = Clock::now();
+    {
+        ThreadPool pool(threads);
+        // A few tasks per thread, so uneven replay lengths still balance
+        size_t chunk = std::max<size_t>(1, entries.size() / (pool.size() * 8));
+        for (size_t first = 0; first < entries.size(); first += chunk) {
+            size_t last = std::min(entries.size(), first + chunk);
+            pool.submit([&entries, first, last] {
+                for (size_t i = first; i < last; ++i) {
+                    Entry& entry = entries[i];
+                    if (!entry.replay) continue;
+                    auto replayStart = Clock::now();
+                    entry.result = playReplay(*entry.replay);
+                    entry.microseconds = std::chrono::duration<double, std::micro>(Clock::now() - replayStart).count();
+                }
+            });
+        }
+        pool.wait();
+    }
+    double elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    size_t played = 0, unreadable = 0, mismatched = 0;
+    uint64_t swaps = 0;
+    std::vector<double> times;
+    for (const Entry& entry : entries) {
+        if (!entry.replay) {
+            ++unreadable;
+            std::fprintf(stderr, "Could not read replay: %s\n", entry.path.c_str());
+            continue;
+        }
+        ++played;
+        swaps += entry.result.swapsApplied;
+        times.push_back(entry.microseconds);
+
+        bool matches = entry.result.score == entry.replay->finalScore;
+        if (!matches) {
+            ++mismatched;
+            std::fprintf(stderr, "Score mismatch: %s: played %d, recorded %d\n",
+                         entry.path.c_str(), entry.result.score, entry.replay->finalScore);
+        }
+        if (verbose && !json) {
+            std::printf("%s: score %d, %d swaps, %.1f us%s\n", entry.path.c_str(), entry.result.score,
+                        entry.result.swapsApplied, entry.microseconds, matches ? "" : " MISMATCH");
+        }
+    }
+    std::sort(times.begin(), times.end());
+
+    double replaysPerSecond = elapsedSeconds > 0.0 ? played / elapsedSeconds : 0.0;
+    if (json) {
+        std::printf("{\n");
+        std::printf("  \"replays\": %zu,\n  \"unreadable\": %zu,\n  \"mismatched\": %zu,\n",
+                    played, unreadable, mismatched);
+        std::printf("  \"swaps\": %llu,\n", static_cast<unsigned long long>(swaps));
+        std::printf("  \"elapsed_seconds\": %.6f,\n", elapsedSeconds);
+        std::printf("  \"replays_per_second\": %.1f,\n", replaysPerSecond);
+        std::printf("  \"replay_us_p50\": %.2f,\n  \"replay_us_p99\": %.2f,\n  \"replay_us_max\": %.2f\n",
+                    percentile(times, 0.5), percentile(times, 0.99), times.empty() ? 0.0 : times.back());
+        std::printf("}\n");
+    } else {
+        std::printf("Replays:            %zu (%zu unreadable, %zu score mismatches)\n",
+                    played, unreadable, mismatched);
+        std::printf("Swaps:              %llu\n", static_cast<unsigned long long>(swaps));
+        std::printf("Elapsed:            %.3f s\n", elapsedSeconds);
+        std::printf("Replays per second: %.0f\n", replaysPerSecond);
+        std::printf("Per replay:         p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                    percentile(times, 0.5), percentile(times, 0.99), times.empty() ? 0.0 : times.back());
+    }
+
+    return unreadable == 0 && mismatched == 0 ? 0 : 1;
+}
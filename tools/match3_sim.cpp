@@ -0,0 +1,162 @@
+// Headless batch simulator: plays many complete games on all cores and
+// prints aggregate statistics. Uses only the SDL-free game logic.
+
+#include "Simulator.h"
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "Options:\n"
+        "  --games N       Number of games to play (default 1000)\n"
+        "  --threads N     Worker threads, 0 = all cores (default 0)\n"
+        "  --policy NAME   Move policy: random, greedy, first, search (default random)\n"
+        "  --seed N        Base seed; same seed gives the same games (default 1)\n"
+        "  --max-moves N   Cut games off after N moves (default 500)\n"
+        "  --level FILE    Read board rows/cols/colors from a level file\n"
+        "  --json          Print statistics as JSON\n"
+        "  --help          Show this message\n",
+        program);
+}
+
+// Accepts decimal numbers up to `max`; rejects signs, overflow and trailing text
+bool parseNumber(const char* text, unsigned long long& value, unsigned long long max) {
+    if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    errno = 0;
+    char* end = nullptr;
+    value = std::strtoull(text, &end, 10);
+    return errno != ERANGE && *end == '\0' && value <= max;
+}
+
+// Largest value a numeric option's config field holds
+unsigned long long numberLimit(const std::string& option) {
+    if (option == "--threads") return std::numeric_limits<unsigned>::max();
+    if (option == "--max-moves") return std::numeric_limits<int>::max();
+    return std::numeric_limits<unsigned long long>::max();
+}
+
+void printText(const SimulationConfig& config, const SimulationStats& stats) {
+    std::printf("Board:            %dx%d, %d colors\n", config.level.rows, config.level.cols, config.level.colors);
+    std::printf("Policy:           %s\n", movePolicyName(config.policy));
+    std::printf("Games:            %llu\n", static_cast<unsigned long long>(stats.games));
+    std::printf("Average score:    %.1f\n", stats.averageScore());
+    std::printf("Average moves:    %.1f (shortest %d, longest %d)\n",
+                stats.averageMoves(), stats.shortestGame, stats.longestGame);
+    std::printf("Out of moves:     %llu games (%.1f%%)\n",
+                static_cast<unsigned long long>(stats.gamesOutOfMoves),
+                stats.games ? 100.0 * stats.gamesOutOfMoves / stats.games : 0.0);
+    std::printf("Elapsed:          %.3f s\n", stats.elapsedSeconds);
+    std::printf("Games per second: %.0f\n", stats.gamesPerSecond());
+    std::printf("\nCascade depth histogram (match rounds per move):\n");
+    for (size_t depth = 1; depth < stats.cascadeDepths.size(); ++depth) {
+        if (stats.cascadeDepths[depth] == 0) continue;
+        std::printf("  %2zu%s %12llu\n", depth,
+                    depth + 1 == stats.cascadeDepths.size() ? "+" : " ",
+                    static_cast<unsigned long long>(stats.cascadeDepths[depth]));
+    }
+}
+
+void printJson(const SimulationConfig& config, const SimulationStats& stats) {
+    std::printf("{\n");
+    std::printf("  \"rows\": %d,\n  \"cols\": %d,\n  \"colors\": %d,\n",
+                config.level.rows, config.level.cols, config.level.colors);
+    std::printf("  \"policy\": \"%s\",\n", movePolicyName(config.policy));
+    std::printf("  \"seed\": %llu,\n", static_cast<unsigned long long>(config.seed));
+    std::printf("  \"games\": %llu,\n", static_cast<unsigned long long>(stats.games));
+    std::printf("  \"average_score\": %.3f,\n", stats.averageScore());
+    std::printf("  \"average_moves\": %.3f,\n", stats.averageMoves());
+    std::printf("  \"shortest_game\": %d,\n  \"longest_game\": %d,\n", stats.shortestGame, stats.longestGame);
+    std::printf("  \"games_out_of_moves\": %llu,\n", static_cast<unsigned long long>(stats.gamesOutOfMoves));
+    std::printf("  \"elapsed_seconds\": %.6f,\n", stats.elapsedSeconds);
+    std::printf("  \"games_per_second\": %.1f,\n", stats.gamesPerSecond());
+    std::printf("  \"cascade_depths\": [");
+    for (size_t depth = 0; depth < stats.cascadeDepths.size(); ++depth) {
+        std::printf("%s%llu", depth ? ", " : "", static_cast<unsigned long long>(stats.cascadeDepths[depth]));
+    }
+    std::printf("]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SimulationConfig config;
+    bool json = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        unsigned long long number = 0;
+
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--json") {
+            json = true;
+            continue;
+        }
+
+        bool takesValue = arg == "--policy" || arg == "--level" || arg == "--games" ||
+                          arg == "--threads" || arg == "--seed" || arg == "--max-moves";
+        if (!takesValue) {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return 1;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--policy") {
+            auto policy = parseMovePolicy(value);
+            if (!policy) {
+                std::fprintf(stderr, "Unknown policy: %s\n", value);
+                return 1;
+            }
+            config.policy = *policy;
+        } else if (arg == "--level") {
+            auto level = loadLevelConfig(value);
+            if (!level) {
+                std::fprintf(stderr, "Could not read level file: %s\n", value);
+                return 1;
+            }
+            config.level = *level;
+        } else if (!parseNumber(value, number, numberLimit(arg))) {
+            std::fprintf(stderr, "Invalid number for %s: %s\n", arg.c_str(), value);
+            return 1;
+        } else if (arg == "--games") {
+            config.games = number;
+        } else if (arg == "--threads") {
+            config.threads = static_cast<unsigned>(number);
+        } else if (arg == "--seed") {
+            config.seed = number;
+        } else {
+            config.maxMoves = static_cast<int>(number);
+        }
+    }
+
+    auto stats = runSimulation(config);
+    if (!stats) {
+        std::fprintf(stderr, "No compiled rules for a %dx%d board with %d colors\n",
+                     config.level.rows, config.level.cols, config.level.colors);
+        return 1;
+    }
+
+    if (json) {
+        printJson(config, *stats);
+    } else {
+        printText(config, *stats);
+    }
+    return 0;
+}